@@ -0,0 +1,110 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "OptionLib/OptionLib.h"
+
+using namespace OptionLib;
+
+namespace {
+
+    const char* simdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar: return "scalar";
+            case SimdLevel::AVX2:   return "AVX2";
+            case SimdLevel::AVX512: return "AVX-512";
+            default: return "unknown";
+        }
+    }
+
+    // Runs the callable `repeats` times and returns options priced per second
+    template <typename F>
+    double throughput(std::size_t count, int repeats, F&& f) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            f();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(count) * repeats / elapsed.count();
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    const int repeats = 5;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> strikeDist(60.0, 140.0), expiryDist(0.05, 3.0), volDist(0.1, 0.6);
+
+    std::vector<double> spot(count, 100.0), strike(count), expiry(count), vol(count), rate(count, 0.03);
+    std::vector<OptionType> type(count);
+    std::vector<OptionSP> options;
+    options.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        strike[i] = strikeDist(rng);
+        expiry[i] = expiryDist(rng);
+        vol[i] = volDist(rng);
+        type[i] = (i % 2 == 0) ? OptionType::Call : OptionType::Put;
+
+        // One asset per contract so the scalar loop sees the same inputs
+        AssetSP asset = Factory::makeSharedAsset("X", spot[i]);
+        asset->set(Param::volatility, vol[i]);
+        asset->set(Param::riskFreeRate, rate[i]);
+        options.push_back(Factory::makeSharedOption(asset, strike[i], expiry[i], type[i]));
+    }
+
+    std::vector<double> prices(count), delta(count), gamma(count), vega(count), theta(count), rho(count);
+    volatile double sink = 0.0;
+
+    BlackScholes model;
+    double scalarLoop = throughput(count, repeats, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            prices[i] = model.price(*options[i]);
+        }
+        sink = prices[count / 2];
+    });
+    std::cout << "BlackScholes::price loop:        " << scalarLoop / 1e6 << " M options/s\n";
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detectedSimdLevel()) {
+            continue;
+        }
+        setSimdLevel(level);
+        BlackScholes::BatchInput input{spot, strike, expiry, vol, rate, type};
+
+        double pricesOnly = throughput(count, repeats, [&] {
+            BlackScholes::priceBatch(input, {.price = prices});
+            sink = prices[count / 2];
+        });
+        double withGreeks = throughput(count, repeats, [&] {
+            BlackScholes::priceBatch(input, {prices, delta, gamma, vega, theta, rho});
+            sink = rho[count / 2];
+        });
+
+        std::cout << "priceBatch (" << simdLevelName(level) << "): " << pricesOnly / 1e6 << " M options/s, "
+                  << withGreeks / 1e6 << " M options/s with Greeks ("
+                  << pricesOnly / scalarLoop << "x the scalar loop)\n";
+
+        // Invert the batch prices back to volatilities, on one thread and across the shared pool
+        BlackScholes::priceBatch(input, {.price = prices});
+        BlackScholes::ImpliedVolatilityInput marketPrices{prices, spot, strike, expiry, rate, type};
+        BlackScholes serialModel(ExecutionContext::serial());
+        double impliedSerial = throughput(count, repeats, [&] {
+            serialModel.impliedVolatilityBatch(marketPrices, {.volatility = vega});
+            sink = vega[count / 2];
+        });
+        double impliedParallel = throughput(count, repeats, [&] {
+            model.impliedVolatilityBatch(marketPrices, {.volatility = vega});
+            sink = vega[count / 2];
+        });
+        std::cout << "impliedVolatilityBatch (" << simdLevelName(level) << "): " << impliedSerial / 1e6
+                  << " M options/s on one thread, " << impliedParallel / 1e6 << " M options/s on the pool\n";
+    }
+    setSimdLevel(detectedSimdLevel());
+    (void)sink;
+}
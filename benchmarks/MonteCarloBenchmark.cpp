@@ -0,0 +1,49 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <chrono>
+#include <iostream>
+#include "OptionLib/OptionLib.h"
+
+using namespace OptionLib;
+
+namespace {
+
+    const char* simdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar: return "scalar";
+            case SimdLevel::AVX2:   return "AVX2";
+            case SimdLevel::AVX512: return "AVX-512";
+            default: return "unknown";
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t numPaths = argc > 1 ? std::stoull(argv[1]) : 8 * MonteCarlo::PathBlockSize;
+
+    AssetSP asset = Factory::makeSharedAsset("X", 100.0);
+    asset->set(Param::volatility, 0.2);
+    asset->set(Param::riskFreeRate, 0.03);
+    Option call(asset, 105.0, 1.0, OptionType::Call);
+
+    // One core, so the figures are paths per second per core
+    MonteCarlo model(ExecutionContext::serial());
+    volatile double sink = 0.0;
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detectedSimdLevel()) {
+            continue;
+        }
+        setSimdLevel(level);
+        auto start = std::chrono::steady_clock::now();
+        sink = model.simulate(call, numPaths).price();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "MonteCarlo::simulate (" << simdLevelName(level) << "): "
+                  << static_cast<double>(numPaths) / elapsed.count() / 1e6 << " M paths/s per core\n";
+    }
+    setSimdLevel(detectedSimdLevel());
+    (void)sink;
+}
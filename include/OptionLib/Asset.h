@@ -5,10 +5,18 @@
 #ifndef ASSET_H
 #define ASSET_H
 
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 
 namespace OptionLib {
 
+    class VolSurface;
+    struct VolatilityQuote;
+
     // Define possible parameter keys as an enum
     enum class Param {
         volatility,
@@ -19,6 +27,24 @@ namespace OptionLib {
         hestonCorrelation,
     };
 
+    inline constexpr std::size_t ParamCount = 6;
+
+    // Immutable, trivially copyable copy of an asset's market data, indexed directly by Param.
+    // Models take one per pricing call instead of querying the asset repeatedly.
+    struct MarketSnapshot {
+        double spotPrice = 0.0;
+        std::array<double, ParamCount> parameters{};
+        std::uint32_t validMask = 0;    // bit i set when parameters[i] has been provided
+        std::uint64_t version = 0;      // version of the asset this snapshot was taken from
+
+        [[nodiscard]] bool has(Param param) const {
+            return validMask & (1u << static_cast<unsigned int>(param));
+        }
+
+        // Throws std::runtime_error if the parameter was never set
+        [[nodiscard]] double get(Param param) const;
+    };
+
     class Asset {
     public:
         Asset(std::string id, double spotPrice);
@@ -26,15 +52,40 @@ namespace OptionLib {
         // Getters
         [[nodiscard]] std::string getId() const;
         [[nodiscard]] double getSpotPrice() const;
+        void setSpotPrice(double spotPrice);
 
         // Optional parameters setters and getters
         void set(Param param, double value);
         [[nodiscard]] double get(Param param) const;
+        [[nodiscard]] bool has(Param param) const;
+
+        // Implied volatility surface; when set, models price each option at its own strike and
+        // expiry's volatility instead of Param::volatility
+        void setVolSurface(std::shared_ptr<const VolSurface> surface);
+        [[nodiscard]] const std::shared_ptr<const VolSurface>& getVolSurface() const;
+
+        // Replaces the quoted expiries of the surface (creating it if needed). Unchanged slices are
+        // shared with the previous surface, which stays valid for anyone still holding it.
+        void updateVolSurface(std::span<const VolatilityQuote> quotes);
+
+        // Increases on every change to the spot price, parameters or volatility surface
+        [[nodiscard]] std::uint64_t getVersion() const;
+        [[nodiscard]] MarketSnapshot snapshot() const;
+        // The snapshot and the surface it belongs to (null if none) from the same read. The
+        // pointer stays valid until the asset's surface is next replaced.
+        [[nodiscard]] MarketSnapshot snapshot(const VolSurface*& surface) const;
+
+        // Increases whenever an option on this asset changes its terms, so a holder of many
+        // options only needs to check their versions after it moves
+        [[nodiscard]] std::uint64_t getOptionTermsVersion() const;
 
     private:
+        friend class Option;
+
         std::string id;          // Unique identifier for the asset (e.g., ticker symbol)
-        double spotPrice;
-        std::unordered_map<Param, double> parameters;
+        MarketSnapshot market;
+        std::shared_ptr<const VolSurface> volSurface;
+        std::uint64_t optionTermsVersion = 0;
     };
 
 } // namespace OptionLib
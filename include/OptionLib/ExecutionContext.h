@@ -0,0 +1,45 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef EXECUTIONCONTEXT_H
+#define EXECUTIONCONTEXT_H
+
+#include <OptionLib/ThreadPool.h>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace OptionLib {
+
+    // Where a model or portfolio runs its parallel work. Copies share the same pool, so one
+    // context can be handed to a Portfolio and all of its models; work nested inside a pool
+    // task is scheduled onto the same workers instead of creating new threads.
+    class ExecutionContext {
+    public:
+        // Uses the library-wide pool (see ThreadPool::configureGlobal)
+        ExecutionContext();
+
+        // Owns a dedicated pool with the given thread count and optional CPU pinning
+        explicit ExecutionContext(unsigned int numThreads, std::vector<int> cpuAffinity = {});
+
+        explicit ExecutionContext(std::shared_ptr<ThreadPool> pool);
+
+        // Runs everything inline on the calling thread
+        static ExecutionContext serial();
+
+        // Number of threads work is spread over (1 for a serial context)
+        [[nodiscard]] unsigned int concurrency() const;
+
+        // See ThreadPool::parallelFor; runs inline on a serial context
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                         const std::function<void(std::size_t, std::size_t)>& body) const;
+
+    private:
+        std::shared_ptr<ThreadPool> pool;
+    };
+
+} // namespace OptionLib
+
+#endif //EXECUTIONCONTEXT_H
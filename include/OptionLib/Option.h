@@ -5,8 +5,10 @@
 #ifndef OPTION_H
 #define OPTION_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 #include "Asset.h"
 
 namespace OptionLib {
@@ -16,26 +18,66 @@ namespace OptionLib {
         Put
     };
 
+    // When the holder may exercise: only at expiry, at any time up to expiry, or on a schedule
+    // of exercise dates (in years from now) plus expiry
+    enum class ExerciseStyle {
+        European,
+        American,
+        Bermudan
+    };
+
+    class PathPayoff;
+
     class Option {
     public:
         Option(std::shared_ptr<Asset> asset, double strikePrice, double timeToExpiry, OptionType type);
 
+        // Path-dependent option: `payoff` replaces the vanilla payoff at expiry
+        Option(std::shared_ptr<Asset> asset, double strikePrice, double timeToExpiry, OptionType type,
+               std::shared_ptr<const PathPayoff> payoff);
+
         std::shared_ptr<Asset> getAsset() const;
         double getStrikePrice() const;
         double getTimeToExpiry() const;
         OptionType getType() const;
+        std::shared_ptr<const PathPayoff> getPathPayoff() const;
+        bool isPathDependent() const;
+        ExerciseStyle getExerciseStyle() const;
+        const std::vector<double>& getExerciseDates() const;
+        bool hasEarlyExercise() const;
 
         void setStrikePrice(double newStrikePrice);
         void setTimeToExpiry(double newTimeToExpiry);
         void setType(OptionType newType);
+        void setPathPayoff(std::shared_ptr<const PathPayoff> newPayoff);
+
+        // exerciseDates is required for Bermudan exercise and must be empty otherwise; dates
+        // must lie in (0, timeToExpiry] and are stored sorted
+        void setExerciseStyle(ExerciseStyle newStyle, std::vector<double> exerciseDates = {});
+
+        // Increases on every change to the option's terms
+        [[nodiscard]] std::uint64_t getVersion() const;
 
         std::string typeToString() const;
 
+        // Identifier used in reports. Unless set, it is built from the asset id and the current
+        // terms, e.g. "SPX Call 100 1.5".
+        [[nodiscard]] std::string getId() const;
+        void setId(std::string newId);
+
     private:
+        // Bumps the option's version and its asset's option-terms version
+        void termsChanged();
+
         std::shared_ptr<Asset> asset;
         double strikePrice;
         double timeToExpiry;
         OptionType type;
+        std::shared_ptr<const PathPayoff> pathPayoff;
+        ExerciseStyle exerciseStyle = ExerciseStyle::European;
+        std::vector<double> exerciseDates;
+        std::uint64_t version = 0;
+        std::string id;
     };
 
 } // namespace OptionLib
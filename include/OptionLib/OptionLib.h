@@ -6,12 +6,19 @@
 #define OPTIONLIB_H
 
 #include <OptionLib/Option.h>
+#include <OptionLib/VolSurface.h>
+#include <OptionLib/PathPayoff.h>
+#include <OptionLib/Simd.h>
+#include <OptionLib/ExecutionContext.h>
 
 #include <OptionLib/models/Model.h>
 #include <OptionLib/models/BlackScholes.h>
 #include <OptionLib/models/MonteCarlo.h>
 #include <OptionLib/models/Binomial.h>
+#include <OptionLib/models/FiniteDifference.h>
 #include <OptionLib/models/Heston.h>
+#include <OptionLib/models/HestonMonteCarlo.h>
+#include <OptionLib/models/HestonCalibrator.h>
 #include <OptionLib/Portfolio.h>
 
 // Type aliases for shared pointer
@@ -21,10 +28,23 @@ using AssetSP = std::shared_ptr<OptionLib::Asset>;
 
 namespace OptionLib {
     using Models::Binomial;
+    using Models::Lattice;
+    using Models::FiniteDifference;
     using Models::BlackScholes;
+    using Models::ImpliedVolatilityStatus;
     using Models::MonteCarlo;
     using Models::Heston;
+    using Models::HestonMonteCarlo;
+    using Models::HestonCalibrator;
     using Models::GreekType;
+    using Models::GreekMask;
+    using Models::Greeks;
+    using Models::AllGreeks;
+    using Models::greekBit;
+    using Models::Valuation;
+    using Models::GreekEstimator;
+    using Models::ControlVariate;
+    using Models::Sampling;
 
     class Factory {
     public:
@@ -0,0 +1,130 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef PATHPAYOFF_H
+#define PATHPAYOFF_H
+
+#include <cstddef>
+#include <string>
+#include "Option.h"
+
+namespace OptionLib {
+
+    // A chunk of simulated paths seen at one monitoring date; arrays hold one value per path
+    struct PathObservation {
+        std::size_t step;           // monitoring date, 0-based
+        double time;                // time of this date
+        double dt;                  // time since the previous date
+        double volatility;
+        const double* previous;     // spots at the previous date (the initial spot at step 0)
+        const double* current;      // spots at this date
+        std::size_t count;
+        const double* variance = nullptr;   // per-path mean variance since the previous date, when volatility is stochastic
+    };
+
+    // Payoff of a path-dependent option, accumulated as the path is simulated. Each path keeps
+    // stateSize() running values (stored state[k * count + path]), so the simulation never
+    // holds more than one monitoring date of a path. The option supplies strike and call/put.
+    class PathPayoff {
+    public:
+        // numObservations equally spaced monitoring dates over (0, expiry]
+        explicit PathPayoff(std::size_t numObservations);
+        virtual ~PathPayoff() = default;
+
+        [[nodiscard]] std::size_t getNumObservations() const;
+
+        [[nodiscard]] virtual std::size_t stateSize() const = 0;
+        [[nodiscard]] virtual std::string name() const = 0;
+
+        virtual void start(double spot, std::size_t count, double* state) const = 0;
+        virtual void observe(const PathObservation& observation, double* state) const = 0;
+
+        // Undiscounted payoff of each path from its terminal spot and final state
+        virtual void settle(double strike, OptionType type, std::size_t count, const double* terminal,
+                            const double* state, double* payoff) const = 0;
+
+    private:
+        std::size_t numObservations;
+    };
+
+    enum class Averaging {
+        Arithmetic,
+        Geometric
+    };
+
+    // Fixed-strike Asian option on the average of the monitoring-date spots
+    class AsianPayoff : public PathPayoff {
+    public:
+        AsianPayoff(Averaging averaging, std::size_t numObservations);
+
+        [[nodiscard]] Averaging getAveraging() const;
+
+        [[nodiscard]] std::size_t stateSize() const override;
+        [[nodiscard]] std::string name() const override;
+        void start(double spot, std::size_t count, double* state) const override;
+        void observe(const PathObservation& observation, double* state) const override;
+        void settle(double strike, OptionType type, std::size_t count, const double* terminal,
+                    const double* state, double* payoff) const override;
+
+    private:
+        Averaging averaging;
+    };
+
+    enum class BarrierType {
+        UpAndOut,
+        UpAndIn,
+        DownAndOut,
+        DownAndIn
+    };
+
+    // Knock-in/knock-out vanilla with a continuously monitored barrier. Between monitoring dates
+    // the path is a Brownian bridge, so rather than checking the barrier only at the dates each
+    // path carries its probability of not having crossed in between:
+    //   P(no crossing) = 1 - exp(-2 ln(H / S_k) ln(H / S_{k+1}) / (sigma^2 dt))
+    // which removes the discrete-monitoring bias without extra random draws.
+    class BarrierPayoff : public PathPayoff {
+    public:
+        BarrierPayoff(BarrierType barrierType, double barrier, std::size_t numObservations);
+
+        [[nodiscard]] BarrierType getBarrierType() const;
+        [[nodiscard]] double getBarrier() const;
+
+        [[nodiscard]] std::size_t stateSize() const override;
+        [[nodiscard]] std::string name() const override;
+        void start(double spot, std::size_t count, double* state) const override;
+        void observe(const PathObservation& observation, double* state) const override;
+        void settle(double strike, OptionType type, std::size_t count, const double* terminal,
+                    const double* state, double* payoff) const override;
+
+    private:
+        BarrierType barrierType;
+        double barrier;
+    };
+
+    enum class LookbackStrike {
+        Fixed,      // max(S_max - K, 0) for calls, max(K - S_min, 0) for puts
+        Floating    // S_T - S_min for calls, S_max - S_T for puts
+    };
+
+    // Lookback on the extremes over the initial spot and the monitoring-date spots
+    class LookbackPayoff : public PathPayoff {
+    public:
+        LookbackPayoff(LookbackStrike strike, std::size_t numObservations);
+
+        [[nodiscard]] LookbackStrike getStrike() const;
+
+        [[nodiscard]] std::size_t stateSize() const override;
+        [[nodiscard]] std::string name() const override;
+        void start(double spot, std::size_t count, double* state) const override;
+        void observe(const PathObservation& observation, double* state) const override;
+        void settle(double strike, OptionType type, std::size_t count, const double* terminal,
+                    const double* state, double* payoff) const override;
+
+    private:
+        LookbackStrike strike;
+    };
+
+} // namespace OptionLib
+
+#endif //PATHPAYOFF_H
@@ -7,39 +7,186 @@
 
 #include "OptionLib/Option.h"
 #include "OptionLib/models/Model.h" // Include the complete Model definition
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
 
 namespace OptionLib {
 
+    // Evaluations run in parallel on the portfolio's execution context. Items are grouped into
+    // tasks by their model's relativeCost (hundreds of closed-form prices per task, one Monte
+    // Carlo or lattice price per task), and totals are summed in item order, so they are
+    // bit-identical across runs and thread counts.
+    //
+    // Positions are also stored by column, grouped by model and underlying, and prices are
+    // computed per group through Model::priceBatch rather than one virtual price() per item:
+    // split like the items above, or whole for models that price whole batches (Heston chains).
+    //
+    // Prices and Greeks are cached per item, keyed on the versions of its asset and option:
+    // after a market-data update only the items on that asset are recomputed. VaR and
+    // ExpectedShortfall are not cached. Versions are checked per group, and the options of a
+    // group are only visited after its asset reports a change to one of its options' terms.
     class Portfolio {
     public:
-        explicit Portfolio(std::shared_ptr<Models::Model> defaultModel = nullptr);
+        explicit Portfolio(std::shared_ptr<Models::Model> defaultModel = nullptr, ExecutionContext context = {});
 
-        void addOption(std::shared_ptr<Option> option, std::shared_ptr<Models::Model> model = nullptr);
+        // quantity scales the option's value, Greeks and risk measures; negative for short positions
+        void addOption(std::shared_ptr<Option> option, std::shared_ptr<Models::Model> model = nullptr,
+                       double quantity = 1.0);
 
         double totalValue() const;
         double totalGreek(Models::GreekType greekType) const;
+        // One value per position: quantity times the option's Greek
         std::vector<double> greekVector(Models::GreekType greekType) const;
 
+        // Requested Greeks of every position (one row per option) in a single pass over the book
+        std::vector<Models::Greeks> greekMatrix(Models::GreekMask mask = Models::AllGreeks) const;
+
         // std::map<std::string, double> sensitivityAnalysis(double spotChange, double volatilityChange) const;
         std::map<std::string, double> concentrationMeasures() const;
 
         double VaR(double confidenceLevel, double holdingPeriod) const;
         double ExpectedShortfall(double confidenceLevel, double holdingPeriod) const;
 
+        // Metrics for riskReport to compute
+        struct ReportRequest {
+            Models::GreekMask greeks = Models::AllGreeks;
+            bool concentration = true;
+            bool valueAtRisk = false;       // VaR and ExpectedShortfall
+            double confidenceLevel = 0.99;
+            double holdingPeriod = 1.0 / 252.0;
+        };
+
+        // One position's contribution; metrics that were not requested stay at zero
+        struct PositionRisk {
+            std::string id;                 // Option::getId
+            double quantity = 0.0;
+            double value = 0.0;             // quantity times price
+            Models::Greeks greeks;          // quantity times each requested Greek
+            double share = 0.0;             // of the total value
+            double VaR = 0.0;
+            double expectedShortfall = 0.0;
+            bool hasValueAtRisk = false;    // false if not requested or the asset has no volatility
+        };
+
+        struct RiskReport {
+            double totalValue = 0.0;
+            Models::Greeks totalGreeks;
+            double VaR = 0.0;
+            double expectedShortfall = 0.0;
+            std::vector<PositionRisk> positions;    // in the order the options were added
+        };
+
+        // Every requested metric from one sweep over the book. Each item is evaluated at most
+        // once: an item missing its price and Greeks gets both from one priceWithGreeks call with
+        // the requested mask, and that price is cached, so totalValue reports the same number.
+        // Other stale prices are batched. VaR and ExpectedShortfall are the lognormal measures
+        // of BlackScholes::lognormalVaR, taken at those prices and each option's volatility for
+        // every model. Totals are the ordered sums of the positions.
+        RiskReport riskReport(const ReportRequest& request) const;
+        RiskReport riskReport() const;
+
+        // Drops every cached value, e.g. after changing a model's settings
+        void invalidateCache();
+
     private:
         struct PortfolioItem {
             std::shared_ptr<Option> option;
             std::shared_ptr<Models::Model> model;
+            double quantity;
+            std::size_t group;      // position group holding the item
+            std::size_t row;        // and its row in that group's columns
+        };
 
-            PortfolioItem(std::shared_ptr<Option> opt, std::shared_ptr<Models::Model> mod)
-                : option(std::move(opt)), model(std::move(mod)) {}
+        // Positions sharing a model and an underlying, one row per item. The columns are
+        // rewritten when an option's terms change (see refreshGroups).
+        struct PositionGroup {
+            const Models::Model* model;
+            const Asset* asset;
+            std::vector<double> strikes;
+            std::vector<double> expiries;
+            std::vector<OptionType> types;
+            std::vector<double> quantities;
+            std::vector<const Option*> options;
+            std::vector<std::size_t> items;             // item index of each row
+            std::vector<std::uint64_t> optionVersions;  // option version each row was read at
+            std::uint64_t assetVersion = 0;             // asset versions the rows' cache entries
+            std::uint64_t optionTermsVersion = 0;       // were last checked against
         };
 
+        // Runs body(i) for every item, one task per entry of taskStarts
+        void forEachItem(const std::function<void(std::size_t)>& body) const;
+        std::vector<double> itemValues(const std::function<double(const PortfolioItem&)>& value) const;
+
+        // Price and Greeks of one item, emptied when its asset or option changes. generation
+        // increases whenever the entry is emptied, so a value computed outside the lock is
+        // stored only if the entry has not been emptied in the meantime.
+        struct CachedValuation {
+            std::uint64_t generation = 0;
+            bool hasPrice = false;
+            double price = 0.0;
+            Models::GreekMask knownGreeks = 0;
+            Models::Greeks greeks;
+        };
+
+        // One entry per item. Queries hold the lock only to find the missing values and to store
+        // them, never while models run, so models may run portfolio queries on the same pool;
+        // copies take the entries but get their own lock.
+        struct ValuationCache {
+            std::vector<CachedValuation> entries;
+            std::mutex mutex;
+
+            ValuationCache() = default;
+            ValuationCache(const ValuationCache& other) : entries(other.entries) {}
+            ValuationCache& operator=(const ValuationCache& other) {
+                entries = other.entries;
+                return *this;
+            }
+        };
+
+        // Rows without a cached price, copied out of their groups' columns under the cache lock
+        // and split into priceBatch calls of about TaskCost within each group
+        struct StaleRows {
+            struct Batch {
+                std::size_t group;
+                std::size_t begin;
+                std::size_t end;
+            };
+            std::vector<std::size_t> items;
+            std::vector<std::uint64_t> generations;
+            std::vector<double> strikes;
+            std::vector<double> expiries;
+            std::vector<OptionType> types;
+            std::vector<const Option*> options;
+            std::vector<Batch> batches;
+        };
+
+        // Empties the entries of rows whose asset or option changed since the last query,
+        // rewriting the columns of changed options; the caller holds the cache lock
+        void refreshGroups() const;
+        // Per-unit prices of every item; rows missing from the cache are priced by group
+        std::vector<double> cachedPrices() const;
+        // Per-unit requested Greeks of every item; only the missing ones are computed. With
+        // withPrices, items missing their price as well get both from one priceWithGreeks call,
+        // and that price is cached for the other queries.
+        std::vector<Models::Greeks> cachedGreeks(Models::GreekMask mask, bool withPrices = false) const;
+        // Quantity times price, per item
+        std::vector<double> positionValues() const;
+
         std::vector<PortfolioItem> items;
+        mutable std::vector<PositionGroup> groups;
+        std::map<std::pair<const Models::Model*, const Asset*>, std::size_t> groupIndex;
+        mutable ValuationCache cache;
+        std::vector<std::size_t> taskStarts;    // first item of each task
+        double openTaskCost = 0.0;              // cost of the last task so far
         std::shared_ptr<Models::Model> defaultModel;
+        ExecutionContext context;
     };
 
 } // namespace OptionLib
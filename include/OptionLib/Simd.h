@@ -0,0 +1,28 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef SIMD_H
+#define SIMD_H
+
+namespace OptionLib {
+
+    // Instruction sets the batched kernels are compiled for
+    enum class SimdLevel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    // Widest instruction set supported by both the build and the running CPU
+    [[nodiscard]] SimdLevel detectedSimdLevel();
+
+    // Instruction set currently used by the batched kernels
+    [[nodiscard]] SimdLevel activeSimdLevel();
+
+    // Restrict the batched kernels to the given level (clamped to the detected one), e.g. for benchmarking
+    void setSimdLevel(SimdLevel level);
+
+} // namespace OptionLib
+
+#endif //SIMD_H
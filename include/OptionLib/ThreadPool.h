@@ -0,0 +1,74 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OptionLib {
+
+    // Persistent work-stealing pool. Each worker owns a deque: it pops its own work LIFO and
+    // steals from the others FIFO. A thread waiting on parallelFor keeps executing queued tasks
+    // instead of blocking, so nested parallel loops (portfolio over model) reuse the same
+    // workers rather than spawning new ones.
+    class ThreadPool {
+    public:
+        // numThreads = 0 uses std::thread::hardware_concurrency(). If cpuAffinity is non-empty,
+        // worker i is pinned to CPU cpuAffinity[i % cpuAffinity.size()] (Linux only).
+        explicit ThreadPool(unsigned int numThreads = 0, std::vector<int> cpuAffinity = {});
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] unsigned int size() const;
+
+        // Calls body(chunkBegin, chunkEnd) over [begin, end) split into chunks of at most `grain`
+        // indices, and returns once all chunks have run. The first exception thrown by a chunk is
+        // rethrown here after the remaining chunks finish.
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                         const std::function<void(std::size_t, std::size_t)>& body);
+
+        // Library-wide pool shared by default execution contexts
+        static std::shared_ptr<ThreadPool> global();
+
+        // Replaces the library-wide pool; contexts created earlier keep the pool they hold
+        static void configureGlobal(unsigned int numThreads, std::vector<int> cpuAffinity = {});
+
+    private:
+        struct TaskGroup;
+        struct Task {
+            std::function<void()> run;
+        };
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void workerLoop(unsigned int index);
+        bool tryRunOne(int preferredQueue);
+        void push(Task task);
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        std::atomic<std::size_t> queuedTasks{0};
+        std::atomic<unsigned int> nextQueue{0};
+        bool stopping = false;
+    };
+
+} // namespace OptionLib
+
+#endif //THREADPOOL_H
@@ -0,0 +1,70 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef VOLSURFACE_H
+#define VOLSURFACE_H
+
+#include <OptionLib/Option.h>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace OptionLib {
+
+    // A market quote: the Black-Scholes implied volatility of one vanilla
+    struct VolatilityQuote {
+        double strike;
+        double expiry;
+        double impliedVolatility;
+        OptionType type = OptionType::Call;
+    };
+
+    // Implied volatility surface built from quotes, interpolated in total variance w = sigma^2 T.
+    // Each expiry is a slice holding its log-strikes and total variances contiguously, with a
+    // monotone (Fritsch-Carlson) cubic between strikes; beyond the outer strikes w continues
+    // linearly with its slope capped at Lee's moment bound of 2. Butterfly arbitrage is not
+    // checked. Between expiries w is linear in time at a fixed strike, and slices are rejected if
+    // w falls from one expiry to the next, so there is no calendar arbitrage between quoted
+    // expiries. Before the first expiry and after the last, the volatility of the nearest slice
+    // is held.
+    //
+    // Slices are immutable and shared between copies, so updating some expiries builds a new
+    // surface that reuses every unchanged slice.
+    class VolSurface {
+    public:
+        VolSurface() = default;
+
+        // Quotes may be in any order; quotes with equal expiries form one slice
+        explicit VolSurface(std::span<const VolatilityQuote> quotes);
+
+        // Replaces the slices of the expiries quoted in `quotes` (adding new expiries), rebuilding
+        // only those slices and re-checking calendar arbitrage against their neighbours
+        void update(std::span<const VolatilityQuote> quotes);
+
+        // Removes one expiry's slice; throws std::invalid_argument if there is none
+        void removeExpiry(double expiry);
+
+        [[nodiscard]] double volatility(double strike, double expiry) const;
+        [[nodiscard]] double totalVariance(double strike, double expiry) const;
+
+        [[nodiscard]] const std::vector<double>& getExpiries() const;
+        [[nodiscard]] bool empty() const;
+
+    private:
+        struct Slice;
+
+        // Total variance of one slice at log-strike k
+        static double sliceVariance(const Slice& slice, double k);
+        static std::shared_ptr<const Slice> buildSlice(double expiry, std::span<const VolatilityQuote> quotes);
+        // Throws if total variance falls between slice `index` and either neighbour
+        void checkCalendar(std::size_t index) const;
+
+        std::vector<double> expiries;
+        std::vector<std::shared_ptr<const Slice>> slices;
+    };
+
+} // namespace OptionLib
+
+#endif //VOLSURFACE_H
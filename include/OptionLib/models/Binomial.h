@@ -10,26 +10,56 @@
 
 namespace OptionLib::Models {
 
+    // Parameterisations of the binomial tree
+    enum class Lattice {
+        CoxRossRubinstein,  // u = e^{sigma sqrt(dt)}, d = 1 / u; error O(1/N), oscillating in N
+        LeisenReimer        // Peizer-Pratt inversion centred on the strike; error O(1/N^2), odd N only
+    };
+
     class Binomial : public Model {
     public:
-        explicit Binomial() = default;
+        static constexpr int DefaultSteps = 10000;
+
+        struct Settings {
+            Lattice lattice = Lattice::CoxRossRubinstein;
+            int numSteps = DefaultSteps;        // rounded up to odd for Leisen-Reimer
+            bool smoothing = false;             // Black-Scholes values one step before expiry
+            bool richardson = false;            // extrapolate from numSteps and about numSteps / 2 steps
+            double targetAccuracy = 0.0;        // > 0: numSteps is ignored and the steps double from 32
+                                                // until three successive prices agree to within this
+        };
+
+        explicit Binomial(ExecutionContext context = {});
+        explicit Binomial(Settings settings, ExecutionContext context = {});
 
         [[nodiscard]] double price(const Option& option) const override;
         [[nodiscard]] double computeGreek(const Option& option, GreekType greekType) const override;
+        [[nodiscard]] Greeks computeGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Price with Delta, Gamma and Theta read off the node values at steps 1 and 2 of the
+        // pricing tree, and Vega and Rho from central bumps priced concurrently on trees with
+        // the same number of steps
+        [[nodiscard]] Valuation priceWithGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        [[nodiscard]] const Settings& getSettings() const;
+        void setSettings(const Settings& newSettings);
 
         [[nodiscard]] double VaR(const Option& option, double confidenceLevel, double holdingPeriod) const override;
         [[nodiscard]] double ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const override;
 
 
     private:
-        static double calculateDelta(const Option& option);
-        static double calculateGamma(const Option& option);
-        static double calculateVega(const Option& option);
-        static double calculateTheta(const Option& option);
-        static double calculateRho(const Option& option);
-
-        static double priceWrapper(const Option& option, double spotPrice, double riskFreeRate, double volatility,
-                                   double strikePrice, double timeToMaturity, int numSimulations);
+        // Price and tree Greeks under the settings: one tree, a Richardson pair or the adaptive
+        // sequence. numSteps > 0 fixes the finer tree's steps; the steps used are written back.
+        Valuation valuationWrapper(const Option& option, double spotPrice, double riskFreeRate, double volatility,
+                                   double strikePrice, double timeToMaturity, int& numSteps) const;
+
+        Valuation treeValuation(const Option& option, double spotPrice, double riskFreeRate, double volatility,
+                                double strikePrice, double timeToMaturity, int numSteps) const;
+
+        [[nodiscard]] Valuation valuation(const Option& option, GreekMask mask) const;
+
+        Settings settings;
 
     };
 
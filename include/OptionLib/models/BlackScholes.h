@@ -6,26 +6,89 @@
 #define BLACKSCHOLES_H
 
 #include "Model.h"
+#include <cstdint>
+#include <span>
 
 namespace OptionLib::Models {
 
+    // Outcome of inverting one price to an implied volatility
+    enum class ImpliedVolatilityStatus : std::uint8_t {
+        Converged,
+        NotConverged,
+        BelowIntrinsic,     // the price is below the option's intrinsic value
+        AboveMaximum        // the price is at or above the spot (call) or discounted strike (put)
+    };
+
     class BlackScholes : public Model {
     public:
-        BlackScholes() = default;
+        explicit BlackScholes(ExecutionContext context = {});
+
+        // Contiguous (structure-of-arrays) inputs for pricing many vanilla options at once; all spans share one length
+        struct BatchInput {
+            std::span<const double> spot;
+            std::span<const double> strike;
+            std::span<const double> expiry;
+            std::span<const double> volatility;
+            std::span<const double> riskFreeRate;
+            std::span<const OptionType> type;
+        };
+
+        // Destinations for the batch results; empty spans are skipped
+        struct BatchOutput {
+            std::span<double> price;
+            std::span<double> delta;
+            std::span<double> gamma;
+            std::span<double> vega;
+            std::span<double> theta;
+            std::span<double> rho;
+        };
+
+        // Vectorised pricer (AVX-512, AVX2 or scalar, chosen at runtime)
+        static void priceBatch(const BatchInput& input, const BatchOutput& output);
+
+        // Model batch entry point: one market snapshot for the whole batch, priced by the vectorised kernel
+        void priceBatch(const OptionBatch& batch, std::span<double> prices) const override;
+
+        // Market prices to invert, with the same layout as BatchInput
+        struct ImpliedVolatilityInput {
+            std::span<const double> price;
+            std::span<const double> spot;
+            std::span<const double> strike;
+            std::span<const double> expiry;
+            std::span<const double> riskFreeRate;
+            std::span<const OptionType> type;
+        };
+
+        // volatility is required; status and iterations may be empty. Failed inversions get a NaN volatility.
+        struct ImpliedVolatilityOutput {
+            std::span<double> volatility;
+            std::span<ImpliedVolatilityStatus> status;
+            std::span<unsigned> iterations;
+        };
+
+        // Implied volatilities to machine precision, typically in two or three Householder steps from
+        // Jaeckel's asymptotic initial guesses. Vectorised like priceBatch; blocks of contracts (e.g. whole
+        // chains) are spread over the model's execution context.
+        void impliedVolatilityBatch(const ImpliedVolatilityInput& input, const ImpliedVolatilityOutput& output) const;
+
+        // Implied volatility of one option from its market price, at the asset's spot and riskFreeRate;
+        // throws std::invalid_argument when the price has no implied volatility
+        [[nodiscard]] double impliedVolatility(const Option& option, double marketPrice) const;
 
         [[nodiscard]] double price(const Option& option) const override;
         [[nodiscard]] double computeGreek(const Option& option, GreekType greekType) const override;
+        [[nodiscard]] Greeks computeGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+        [[nodiscard]] double relativeCost() const override;
 
         [[nodiscard]] double VaR(const Option& option, double confidenceLevel, double holdingPeriod) const override;
         [[nodiscard]] double ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const override;
 
+        // VaR and ExpectedShortfall of one unit worth `price` whose value is lognormal with the
+        // given volatility, as the overrides above compute them at the option's own volatility
+        [[nodiscard]] static double lognormalVaR(double price, double volatility, double confidenceLevel, double holdingPeriod);
+        [[nodiscard]] static double lognormalExpectedShortfall(double price, double volatility, double confidenceLevel,
+                                                               double holdingPeriod);
 
-    private:
-        static double calculateDelta(const Option& option);
-        static double calculateGamma(const Option& option);
-        static double calculateVega(const Option& option);
-        static double calculateTheta(const Option& option);
-        static double calculateRho(const Option& option);
     };
 
 } // namespace OptionLib::Models
@@ -7,28 +7,49 @@
 
 #include "Model.h"
 #include <complex>
+#include <span>
+#include <vector>
 
 namespace OptionLib::Models {
 
     class Heston : public Model {
     public:
-        Heston() = default;
+        explicit Heston(ExecutionContext context = {});
 
         static std::complex<double> characteristicFunction(const std::complex<double>& u, const Option& option, const Asset& asset) ;
 
         [[nodiscard]] double price(const Option& option) const override;
         [[nodiscard]] double computeGreek(const Option& option, GreekType greekType) const override;
+        [[nodiscard]] Greeks computeGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Price and all five Greeks from one pass over the Fourier series, differentiating the
+        // characteristic function analytically. Vega is taken with respect to Param::volatility
+        // (the square root of v0), as for the other models.
+        [[nodiscard]] Valuation priceWithGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Prices of vanillas on one asset and expiry, one per strike. The characteristic function
+        // is evaluated once for the whole chain, on the truncation range shared by every strike.
+        [[nodiscard]] std::vector<double> priceChain(const Asset& asset, double expiry, std::span<const double> strikes,
+                                                     OptionType type) const;
+
+        // Rows sharing an expiry and type are priced together through priceChain
+        void priceBatch(const OptionBatch& batch, std::span<double> prices) const override;
+        [[nodiscard]] bool pricesWholeBatches() const override;
+
+        // Target absolute error of the Fourier series. With a tolerance the truncation range
+        // (from moment bounds on the tails of ln S_T) and the number of terms adapt to each
+        // expiry. The term count is the smallest for which a bound on the omitted terms of the
+        // price and of each Greek series is below half of it. The bound comes from an envelope
+        // of |phi(u)| that decays exponentially unless |correlation| = 1, when 16384 terms are
+        // kept. 0, the default, keeps the fixed 24-sigma range and 1021 terms.
+        [[nodiscard]] double getTolerance() const;
+        void setTolerance(double newTolerance);
 
         [[nodiscard]] double VaR(const Option& option, double confidenceLevel, double holdingPeriod) const override;
         [[nodiscard]] double ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const override;
 
-
     private:
-        static double calculateDelta(const Option& option);
-        static double calculateGamma(const Option& option);
-        static double calculateVega(const Option& option);
-        static double calculateTheta(const Option& option);
-        static double calculateRho(const Option& option);
+        double tolerance = 0.0;
     };
 
 } // namespace OptionLib::Models
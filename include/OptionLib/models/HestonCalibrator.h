@@ -0,0 +1,67 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef HESTONCALIBRATOR_H
+#define HESTONCALIBRATOR_H
+
+#include <OptionLib/Asset.h>
+#include <OptionLib/ExecutionContext.h>
+#include <OptionLib/Option.h>
+#include <OptionLib/VolSurface.h>
+#include <chrono>
+#include <span>
+
+namespace OptionLib::Models {
+
+    // Fits the Heston parameters of an asset to a surface of implied volatilities with
+    // Levenberg-Marquardt. Quote errors are model-minus-market prices divided by the market
+    // Black-Scholes vega, i.e. roughly implied-volatility errors. Each iteration prices every
+    // quote, with its exact parameter gradient, from one characteristic-function evaluation
+    // per expiry; expiries are spread over the execution context. The Fourier truncation range of
+    // each expiry is fixed at the starting parameters for the whole calibration, which is what
+    // makes the gradient exact.
+    class HestonCalibrator {
+    public:
+        struct Parameters {
+            double volatility;          // sqrt(v0)
+            double meanReversion;
+            double longTermVariance;
+            double volOfVol;
+            double correlation;
+        };
+
+        struct Settings {
+            unsigned maxIterations = 100;
+            double tolerance = 1e-10;       // stop when a step improves the error by less than this fraction
+            double initialDamping = 1e-3;
+        };
+
+        struct Result {
+            Parameters parameters{};
+            double rootMeanSquareError = 0.0;       // of the vega-scaled price errors
+            unsigned iterations = 0;                // Levenberg-Marquardt steps tried
+            unsigned evaluations = 0;               // passes over the whole surface
+            std::chrono::microseconds wallTime{0};
+            bool converged = false;
+        };
+
+        explicit HestonCalibrator(ExecutionContext context = {});
+        explicit HestonCalibrator(Settings settings, ExecutionContext context = {});
+
+        // Calibrates to quotes on `asset`, whose spot price and riskFreeRate are taken as given.
+        // Warm-starts from the asset's current Heston parameters when all five are set (e.g.
+        // yesterday's fit), and writes the calibrated parameters back to the asset.
+        Result calibrate(Asset& asset, std::span<const VolatilityQuote> quotes) const;
+
+        [[nodiscard]] const Settings& getSettings() const;
+        void setSettings(const Settings& newSettings);
+
+    private:
+        Settings settings;
+        ExecutionContext context;
+    };
+
+} // namespace OptionLib::Models
+
+#endif //HESTONCALIBRATOR_H
@@ -0,0 +1,80 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef HESTONMONTECARLO_H
+#define HESTONMONTECARLO_H
+
+#include "MonteCarlo.h"
+
+namespace OptionLib::Models {
+
+    // Monte Carlo under the Heston model, discretised with Andersen's Quadratic-Exponential (QE)
+    // scheme and its martingale correction. Takes the same asset parameters as Heston, with
+    // Param::volatility as the initial volatility (v0 = volatility^2). Supports vanilla and
+    // path-dependent options, pseudo-random sampling, antithetic pairs and the TerminalSpot
+    // control variate.
+    class HestonMonteCarlo : public Model {
+    public:
+        static constexpr unsigned DefaultStepsPerYear = 100;
+
+        explicit HestonMonteCarlo(ExecutionContext context = {});
+        explicit HestonMonteCarlo(MonteCarlo::Settings settings, ExecutionContext context = {});
+
+        [[nodiscard]] double price(const Option& option) const override;
+        [[nodiscard]] double computeGreek(const Option& option, GreekType greekType) const override;
+        [[nodiscard]] Greeks computeGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Runs batches until the target standard error, the deadline or maxPaths is reached
+        [[nodiscard]] MonteCarlo::Estimate estimate(const Option& option) const;
+
+        // Price and all five Greeks by bump-and-revalue on common random numbers, maxPaths paths
+        // per scenario. Vega is the sensitivity to Param::volatility.
+        [[nodiscard]] Valuation priceWithGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Simulates numPaths more paths after `from`; resumable and thread-count independent as
+        // for MonteCarlo::simulate
+        [[nodiscard]] MonteCarlo::Checkpoint simulate(const Option& option, std::uint64_t numPaths,
+                                                      const MonteCarlo::Checkpoint& from) const;
+        [[nodiscard]] MonteCarlo::Checkpoint simulate(const Option& option, std::uint64_t numPaths) const;
+
+        [[nodiscard]] const MonteCarlo::Settings& getSettings() const;
+        void setSettings(const MonteCarlo::Settings& newSettings);
+
+        [[nodiscard]] std::uint64_t getSeed() const;
+        void setSeed(std::uint64_t newSeed);
+
+        // Time steps per year of expiry; path payoffs step at least once per monitoring date
+        [[nodiscard]] unsigned getStepsPerYear() const;
+        void setStepsPerYear(unsigned newStepsPerYear);
+
+        [[nodiscard]] double VaR(const Option& option, double confidenceLevel, double holdingPeriod) const override;
+        [[nodiscard]] double ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const override;
+
+    private:
+        struct Dynamics {
+            double spot;
+            double rate;
+            double variance;            // v0
+            double meanReversion;       // kappa
+            double longTermVariance;    // theta
+            double volOfVol;            // zeta
+            double correlation;         // rho
+        };
+
+        static Dynamics readDynamics(const MarketSnapshot& market);
+
+        [[nodiscard]] std::size_t stepsPerDate(const Option& option) const;
+
+        MonteCarlo::Checkpoint priceWrapper(const Option& option, const Dynamics& dynamics, double timeToMaturity,
+                                            std::size_t stepsPerDate, std::uint64_t numSimulations,
+                                            const MonteCarlo::Checkpoint& from) const;
+
+        MonteCarlo::Settings settings;
+        std::uint64_t seed = MonteCarlo::DefaultSeed;
+        unsigned stepsPerYear = DefaultStepsPerYear;
+    };
+
+} // namespace OptionLib::Models
+
+#endif //HESTONMONTECARLO_H
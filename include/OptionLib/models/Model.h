@@ -6,6 +6,8 @@
 #define MODEL_H
 
 #include <OptionLib/Option.h>
+#include <OptionLib/ExecutionContext.h>
+#include <span>
 
 namespace OptionLib::Models {
 
@@ -17,16 +19,93 @@ namespace OptionLib::Models {
         Rho
     };
 
+    // Bit flags selecting which Greeks computeGreeks should evaluate
+    using GreekMask = unsigned int;
+
+    constexpr GreekMask greekBit(GreekType type) {
+        return 1u << static_cast<unsigned int>(type);
+    }
+
+    inline constexpr GreekMask AllGreeks = greekBit(GreekType::Delta) | greekBit(GreekType::Gamma) |
+                                           greekBit(GreekType::Vega) | greekBit(GreekType::Theta) |
+                                           greekBit(GreekType::Rho);
+
+    // Greeks of one option; entries not requested in the mask are left at zero
+    struct Greeks {
+        double delta = 0.0;
+        double gamma = 0.0;
+        double vega = 0.0;
+        double theta = 0.0;
+        double rho = 0.0;
+
+        [[nodiscard]] double get(GreekType type) const;
+        void set(GreekType type, double value);
+    };
+
+    // Price of one option together with its Greeks
+    struct Valuation {
+        double price = 0.0;
+        Greeks greeks;
+    };
+
+    // Options on one asset, stored by column: row i has strike[i], expiry[i] and type[i], and
+    // options[i] is the full contract for models that need its exercise style or path payoff
+    struct OptionBatch {
+        const Asset* asset = nullptr;
+        std::span<const double> strike;
+        std::span<const double> expiry;
+        std::span<const OptionType> type;
+        std::span<const Option* const> options;
+    };
+
     class Model {
     public:
+        explicit Model(ExecutionContext context = {});
         virtual ~Model();
 
+        // Pool used by models that parallelise internally
+        [[nodiscard]] const ExecutionContext& getExecutionContext() const;
+        void setExecutionContext(ExecutionContext newContext);
+
         virtual double VaR(const Option& option, double confidenceLevel, double holdingPeriod) const = 0;
         virtual double ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const = 0;
 
         virtual double price(const Option& option) const = 0;
         virtual double computeGreek(const Option& option, GreekType type) const = 0;
 
+        // Writes the price of every row of `batch` to prices. The default calls price() per
+        // option; models override it with vectorised or chain-aware versions.
+        virtual void priceBatch(const OptionBatch& batch, std::span<double> prices) const;
+
+        // True when priceBatch shares work between rows and parallelises internally, so callers
+        // should pass all their rows at once instead of splitting them by relativeCost
+        [[nodiscard]] virtual bool pricesWholeBatches() const;
+
+        // All requested Greeks in one evaluation. The default calls computeGreek once per Greek;
+        // models override it to share intermediate results between Greeks.
+        virtual Greeks computeGreeks(const Option& option, GreekMask mask = AllGreeks) const;
+
+        // Price and the Greeks in mask. The default calls price() and computeGreeks(option, mask);
+        // models that get both from one evaluation (a tree, a grid, a simulation) override it and
+        // may fill Greeks outside the mask as well.
+        virtual Valuation priceWithGreeks(const Option& option, GreekMask mask = AllGreeks) const;
+
+        // Rough cost of one evaluation relative to a closed-form Black-Scholes price. Portfolio
+        // packs cheap items into large tasks and schedules expensive ones one per task.
+        [[nodiscard]] virtual double relativeCost() const;
+
+    protected:
+        // Throws for path-dependent options in models that only price vanillas
+        static void requireVanilla(const Option& option, const char* modelName);
+
+        // Throws for early-exercise options in models that only price European payoffs
+        static void requireEuropean(const Option& option, const char* modelName);
+
+        // The option's volatility: from `surface` (taken with the snapshot, see Asset::snapshot) at
+        // its strike and expiry, or Param::volatility if the asset has no surface
+        static double optionVolatility(const Option& option, const MarketSnapshot& market, const VolSurface* surface);
+
+        ExecutionContext context;
     };
 
 } // namespace OptionLib::Models
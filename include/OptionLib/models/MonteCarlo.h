@@ -6,17 +6,103 @@
 #define MONTECARLO_H
 
 #include "Model.h"
-#include <random>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 
 namespace OptionLib::Models {
 
+    // How MonteCarlo estimates Greeks
+    enum class GreekEstimator {
+        Pathwise,               // pathwise Delta/Vega/Theta/Rho and likelihood-ratio Gamma, read off the pricing paths
+        CommonRandomNumbers     // central bumps revalued on the same paths; valid for any payoff
+    };
+
+    // Control variates for MonteCarlo pricing
+    enum class ControlVariate {
+        None,
+        TerminalSpot,       // discounted S_T, whose mean is the spot price
+        BlackScholes        // for path-dependent payoffs, the vanilla payoff on the same path, whose mean is the
+                            // closed-form Black-Scholes price; vanillas use TerminalSpot instead
+    };
+
+    // Source of the normals driving each MonteCarlo path
+    enum class Sampling {
+        PseudoRandom,   // Philox streams; error estimated from the path sample
+        Sobol           // digitally shifted Sobol points; error estimated across independent shifts
+    };
+
     class MonteCarlo : public Model {
     public:
-        explicit MonteCarlo() = default;
+        // Paths are reduced in blocks of this many, aligned to multiples of it
+        static constexpr std::uint64_t PathBlockSize = 1 << 16;
+        static constexpr std::uint64_t DefaultSeed = 0x5EED0F0F71011B5Full;
+
+        struct Settings {
+            std::uint64_t maxPaths = 10'000'000;                // path budget (antithetic mirrors included)
+            std::uint64_t batchPaths = 16 * PathBlockSize;      // stopping rules are checked after each batch
+            bool antithetic = false;                            // pair every draw Z with -Z
+            ControlVariate controlVariate = ControlVariate::None;
+            double targetStandardError = 0.0;                   // stop once reached (0 runs all maxPaths)
+            std::chrono::milliseconds deadline{0};              // wall-clock budget (0 for none)
+            Sampling sampling = Sampling::PseudoRandom;
+            unsigned randomizations = 16;                       // independent Sobol shifts sharing the path budget
+        };
+
+        // Price with its standard error and the number of paths spent
+        struct Estimate {
+            double price = 0.0;
+            double standardError = 0.0;
+            std::uint64_t numPaths = 0;
+        };
+
+        // Running sample statistics of a pricing simulation. A sample is one path, or an
+        // antithetic pair; X is its payoff and Y the control variate.
+        struct Checkpoint {
+            std::uint64_t numSamples = 0;
+            std::uint64_t pathsPerSample = 1;
+            double sumX = 0.0, sumXX = 0.0;
+            double sumY = 0.0, sumYY = 0.0, sumXY = 0.0;
+            bool hasControl = false;
+            double controlMean = 0.0;       // known expectation of Y
+            double discountFactor = 1.0;
+            std::uint32_t replicate = 0;    // which Sobol shift drives the paths
+
+            [[nodiscard]] std::uint64_t numPaths() const { return numSamples * pathsPerSample; }
+            [[nodiscard]] double price() const;
+            [[nodiscard]] double standardError() const;
+        };
+
+        explicit MonteCarlo(ExecutionContext context = {});
+        explicit MonteCarlo(GreekEstimator estimator, ExecutionContext context = {});
+        explicit MonteCarlo(Settings settings, ExecutionContext context = {});
 
         [[nodiscard]] double price(const Option& option) const override;
         [[nodiscard]] double computeGreek(const Option& option, GreekType greekType) const override;
+        [[nodiscard]] Greeks computeGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Runs batches until the target standard error, the deadline or maxPaths is reached
+        [[nodiscard]] Estimate estimate(const Option& option) const;
+
+        // Price and all five Greeks from a single simulation of maxPaths paths. Path-dependent
+        // options always use bump-and-revalue on common random numbers. Sobol sampling uses a
+        // single shift here, so unlike estimate() there is no error estimate behind the result.
+        [[nodiscard]] Valuation priceWithGreeks(const Option& option, GreekMask mask = AllGreeks) const override;
+
+        // Simulates numPaths more paths after `from`. Path i always uses the same draws, so a run
+        // resumed from a checkpoint taken at a multiple of PathBlockSize is bit-identical to an
+        // uninterrupted one, on any number of threads.
+        [[nodiscard]] Checkpoint simulate(const Option& option, std::uint64_t numPaths, const Checkpoint& from) const;
+        [[nodiscard]] Checkpoint simulate(const Option& option, std::uint64_t numPaths) const;
+
+        [[nodiscard]] GreekEstimator getGreekEstimator() const;
+        void setGreekEstimator(GreekEstimator estimator);
+
+        [[nodiscard]] const Settings& getSettings() const;
+        void setSettings(const Settings& newSettings);
+
+        [[nodiscard]] std::uint64_t getSeed() const;
+        void setSeed(std::uint64_t newSeed);
 
         // Implement VaR and Expected Shortfall with Monte Carlo
         [[nodiscard]] double VaR(const Option& option, double confidenceLevel, double holdingPeriod) const override;
@@ -24,14 +110,20 @@ namespace OptionLib::Models {
 
 
     private:
-        static double calculateDelta(const Option& option);
-        static double calculateGamma(const Option& option);
-        static double calculateVega(const Option& option);
-        static double calculateTheta(const Option& option);
-        static double calculateRho(const Option& option);
-
-        static double priceWrapper(const Option& option, double spotPrice, double riskFreeRate, double volatility,
-                                   double strikePrice, double timeToMaturity, int numSimulations);
+        Checkpoint priceWrapper(const Option& option, double spotPrice, double riskFreeRate, double volatility,
+                                double strikePrice, double timeToMaturity, std::uint64_t numSimulations,
+                                const Checkpoint& from) const;
+
+        Valuation pathwiseWrapper(const Option& option, const MarketSnapshot& market, const VolSurface* surface,
+                                  std::uint64_t numSimulations) const;
+        Valuation commonRandomNumbersWrapper(const Option& option, const MarketSnapshot& market, const VolSurface* surface,
+                                             std::uint64_t numSimulations) const;
+        Valuation pathDependentWrapper(const Option& option, const MarketSnapshot& market, const VolSurface* surface,
+                                       std::uint64_t numSimulations) const;
+
+        Settings settings;
+        GreekEstimator greekEstimator = GreekEstimator::Pathwise;
+        std::uint64_t seed = DefaultSeed;
     };
 
 } // namespace OptionLib::Models
@@ -0,0 +1,39 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef BROWNIANBRIDGE_H
+#define BROWNIANBRIDGE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace OptionLib::Random {
+
+    // Builds a Brownian path on a fixed time grid from independent standard normals, terminal
+    // value first and then repeatedly the midpoint of the widest gap. The first normals fix the
+    // coarse shape of the path that most payoffs depend on, so feeding them from the leading
+    // (best distributed) Sobol dimensions concentrates the effective dimension of a QMC run.
+    class BrownianBridge {
+    public:
+        // Grid times t_1 < ... < t_n, all > 0; the path starts at W(0) = 0
+        explicit BrownianBridge(std::vector<double> times);
+
+        // n equal steps over (0, maturity]
+        BrownianBridge(std::size_t numSteps, double maturity);
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] const std::vector<double>& times() const;
+
+        // path[i] = W(t_i) from normals[0..n); normals[0] sets the terminal value
+        void build(const double* normals, double* path) const;
+
+    private:
+        std::vector<double> grid;
+        std::vector<std::size_t> bridgeIndex, leftIndex, rightIndex;   // leftIndex 0 means t = 0
+        std::vector<double> leftWeight, rightWeight, stdDev;
+    };
+
+} // namespace OptionLib::Random
+
+#endif //BROWNIANBRIDGE_H
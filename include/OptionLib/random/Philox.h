@@ -0,0 +1,91 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace OptionLib::Random {
+
+    // Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers: as easy as
+    // 1, 2, 3", SC'11). The output is a pure function of (counter, key), so any draw can be
+    // produced directly from its index: skip-ahead is O(1) and streams need no shared state.
+    class Philox4x32 {
+    public:
+        using Counter = std::array<std::uint32_t, 4>;
+        using Key = std::array<std::uint32_t, 2>;
+
+        static constexpr Counter generate(Counter counter, Key key) {
+            for (int round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    key[0] += 0x9E3779B9u;
+                    key[1] += 0xBB67AE85u;
+                }
+                std::uint64_t product0 = std::uint64_t{0xD2511F53u} * counter[0];
+                std::uint64_t product1 = std::uint64_t{0xCD9E8D57u} * counter[2];
+                counter = {
+                    static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                    static_cast<std::uint32_t>(product1),
+                    static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                    static_cast<std::uint32_t>(product0)
+                };
+            }
+            return counter;
+        }
+
+        static constexpr Key makeKey(std::uint64_t seed) {
+            return {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+        }
+
+        // Uniform on the open interval (0, 1) with 53 random bits
+        static constexpr double toUniform(std::uint32_t hi, std::uint32_t lo) {
+            std::uint64_t bits = (std::uint64_t{hi} << 32 | lo) >> 11;
+            return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+        }
+    };
+
+    // Standard normal draws of one Monte Carlo path. Draw j of path i depends only on
+    // (seed, i, j), never on which thread or batch produces it.
+    class NormalStream {
+    public:
+        NormalStream(std::uint64_t seed, std::uint64_t path)
+            : key(Philox4x32::makeKey(seed)), path(path) {}
+
+        // Next draw of this path (Box-Muller on one Philox block gives two draws)
+        double next() {
+            if (draw % 2 == 0) {
+                auto block = Philox4x32::generate(
+                    {static_cast<std::uint32_t>(path), static_cast<std::uint32_t>(path >> 32),
+                     static_cast<std::uint32_t>(draw / 2), static_cast<std::uint32_t>(draw >> 33)}, key);
+                double radius = std::sqrt(-2.0 * std::log(Philox4x32::toUniform(block[0], block[1])));
+                double angle = 6.283185307179586477 * Philox4x32::toUniform(block[2], block[3]);
+                cached = radius * std::sin(angle);
+                ++draw;
+                return radius * std::cos(angle);
+            }
+            ++draw;
+            return cached;
+        }
+
+        // Jump to draw j of this path in O(1)
+        void skipTo(std::uint64_t j) {
+            draw = j - j % 2;
+            if (j % 2 == 1) {
+                next();
+            }
+        }
+
+    private:
+        Philox4x32::Key key;
+        std::uint64_t path;
+        std::uint64_t draw = 0;
+        double cached = 0.0;
+    };
+
+} // namespace OptionLib::Random
+
+#endif //PHILOX_H
@@ -0,0 +1,47 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OptionLib::Random {
+
+    // Sobol low-discrepancy sequence in up to MaxDimensions dimensions, with the primitive
+    // polynomials and initial direction numbers of Joe & Kuo (new-joe-kuo-6.21201), generated in
+    // Gray-code order with 32-bit precision. Point n can be reached directly, so threads each
+    // take a disjoint index range of the same sequence.
+    //
+    // A scrambled sequence XORs every coordinate with a random digital shift drawn from the
+    // seed. Each shift keeps the low-discrepancy structure, and prices from independent shifts
+    // are i.i.d. unbiased estimates, which is what gives randomised QMC its error bars.
+    class Sobol {
+    public:
+        static constexpr unsigned MaxDimensions = 21;
+
+        explicit Sobol(unsigned dimensions);
+        Sobol(unsigned dimensions, std::uint64_t scrambleSeed);
+
+        [[nodiscard]] unsigned dimensions() const;
+        [[nodiscard]] std::uint64_t index() const;
+
+        // Jump to point n in O(dimensions * 32)
+        void skipTo(std::uint64_t n);
+
+        // Writes the coordinates of the current point, each strictly inside (0, 1), and advances
+        void next(double* point);
+
+    private:
+        unsigned numDimensions;
+        std::uint64_t current = 0;
+        std::vector<std::uint32_t> directions;     // 32 per dimension
+        std::vector<std::uint32_t> state;
+        std::vector<std::uint32_t> shift;
+    };
+
+} // namespace OptionLib::Random
+
+#endif //SOBOL_H
@@ -4,35 +4,84 @@
 
 #include <string>
 #include <stdexcept>
+#include <type_traits>
 #include <OptionLib/Asset.h>
+#include <OptionLib/VolSurface.h>
 
 namespace OptionLib {
 
+    static_assert(std::is_trivially_copyable_v<MarketSnapshot>, "MarketSnapshot must stay trivially copyable");
+
+    double MarketSnapshot::get(Param param) const {
+        if (!has(param)) {
+            throw std::runtime_error("Parameter not found");
+        }
+        return parameters[static_cast<std::size_t>(param)];
+    }
+
     Asset::Asset(std::string id, double spotPrice)
-        : id(std::move(id)), spotPrice(spotPrice) {}
+        : id(std::move(id)) {
+        market.spotPrice = spotPrice;
+    }
 
     std::string Asset::getId() const {
         return id;
     }
 
     double Asset::getSpotPrice() const {
-        return spotPrice;
+        return market.spotPrice;
+    }
+
+    void Asset::setSpotPrice(double spotPrice) {
+        market.spotPrice = spotPrice;
+        ++market.version;
     }
 
     // Optional parameter setters and getters
     void Asset::set(Param param, double value) {
-        parameters[param] = value;
+        market.parameters[static_cast<std::size_t>(param)] = value;
+        market.validMask |= 1u << static_cast<unsigned int>(param);
+        ++market.version;
     }
 
     double Asset::get(Param param) const {
-        auto it = parameters.find(param);
-        if (it != parameters.end()) {
-            return it->second;
-        } else {
-            throw std::runtime_error("Parameter not found");
-        }
+        return market.get(param);
+    }
+
+    bool Asset::has(Param param) const {
+        return market.has(param);
     }
 
+    void Asset::setVolSurface(std::shared_ptr<const VolSurface> surface) {
+        volSurface = std::move(surface);
+        ++market.version;
+    }
+
+    const std::shared_ptr<const VolSurface>& Asset::getVolSurface() const {
+        return volSurface;
+    }
+
+    void Asset::updateVolSurface(std::span<const VolatilityQuote> quotes) {
+        auto surface = volSurface ? std::make_shared<VolSurface>(*volSurface) : std::make_shared<VolSurface>();
+        surface->update(quotes);
+        setVolSurface(std::move(surface));
+    }
+
+    std::uint64_t Asset::getVersion() const {
+        return market.version;
+    }
+
+    MarketSnapshot Asset::snapshot() const {
+        return market;
+    }
 
+    MarketSnapshot Asset::snapshot(const VolSurface*& surface) const {
+        surface = volSurface.get();
+        return market;
+    }
+
+    std::uint64_t Asset::getOptionTermsVersion() const {
+        return optionTermsVersion;
+    }
 
 } // namespace OptionLib
@@ -0,0 +1,40 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/ExecutionContext.h>
+#include <algorithm>
+
+namespace OptionLib {
+
+    ExecutionContext::ExecutionContext()
+        : pool(ThreadPool::global()) {}
+
+    ExecutionContext::ExecutionContext(unsigned int numThreads, std::vector<int> cpuAffinity)
+        : pool(std::make_shared<ThreadPool>(numThreads, std::move(cpuAffinity))) {}
+
+    ExecutionContext::ExecutionContext(std::shared_ptr<ThreadPool> pool)
+        : pool(std::move(pool)) {}
+
+    ExecutionContext ExecutionContext::serial() {
+        return ExecutionContext(std::shared_ptr<ThreadPool>());
+    }
+
+    unsigned int ExecutionContext::concurrency() const {
+        return pool ? pool->size() : 1;
+    }
+
+    void ExecutionContext::parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                                       const std::function<void(std::size_t, std::size_t)>& body) const {
+        if (!pool) {
+            // Same chunking as the pool, so chunk-dependent results do not change
+            grain = grain == 0 ? 1 : grain;
+            for (std::size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grain) {
+                body(chunkBegin, std::min(end, chunkBegin + grain));
+            }
+            return;
+        }
+        pool->parallelFor(begin, end, grain, body);
+    }
+
+} // namespace OptionLib
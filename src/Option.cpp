@@ -5,6 +5,8 @@
 #include <OptionLib/Option.h>
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
+#include <sstream>
 
 namespace OptionLib {
 
@@ -18,6 +20,12 @@ namespace OptionLib {
         }
     }
 
+    Option::Option(std::shared_ptr<Asset> asset, double strikePrice, double timeToExpiry, OptionType type,
+                   std::shared_ptr<const PathPayoff> payoff)
+        : Option(std::move(asset), strikePrice, timeToExpiry, type) {
+        pathPayoff = std::move(payoff);
+    }
+
     std::shared_ptr<Asset> Option::getAsset() const {
         return asset;
     }
@@ -34,11 +42,32 @@ namespace OptionLib {
         return type;
     }
 
+    std::shared_ptr<const PathPayoff> Option::getPathPayoff() const {
+        return pathPayoff;
+    }
+
+    bool Option::isPathDependent() const {
+        return pathPayoff != nullptr;
+    }
+
+    ExerciseStyle Option::getExerciseStyle() const {
+        return exerciseStyle;
+    }
+
+    const std::vector<double>& Option::getExerciseDates() const {
+        return exerciseDates;
+    }
+
+    bool Option::hasEarlyExercise() const {
+        return exerciseStyle != ExerciseStyle::European;
+    }
+
     void Option::setStrikePrice(double newStrikePrice) {
         if (newStrikePrice <= 0) {
             throw std::invalid_argument("Strike price must be positive.");
         }
         strikePrice = newStrikePrice;
+        termsChanged();
     }
 
     void Option::setTimeToExpiry(double newTimeToExpiry) {
@@ -46,14 +75,60 @@ namespace OptionLib {
             throw std::invalid_argument("Time to expiry must be positive.");
         }
         timeToExpiry = newTimeToExpiry;
+        termsChanged();
     }
 
     void Option::setType(OptionType newType) {
         type = newType;
+        termsChanged();
+    }
+
+    void Option::setPathPayoff(std::shared_ptr<const PathPayoff> newPayoff) {
+        pathPayoff = std::move(newPayoff);
+        termsChanged();
+    }
+
+    void Option::setExerciseStyle(ExerciseStyle newStyle, std::vector<double> newExerciseDates) {
+        if ((newStyle == ExerciseStyle::Bermudan) == newExerciseDates.empty()) {
+            throw std::invalid_argument("Exercise dates are required for, and only for, Bermudan exercise.");
+        }
+        for (double date : newExerciseDates) {
+            if (date <= 0 || date > timeToExpiry) {
+                throw std::invalid_argument("Exercise dates must lie between now and expiry.");
+            }
+        }
+        std::sort(newExerciseDates.begin(), newExerciseDates.end());
+        exerciseStyle = newStyle;
+        exerciseDates = std::move(newExerciseDates);
+        termsChanged();
+    }
+
+    std::uint64_t Option::getVersion() const {
+        return version;
+    }
+
+    void Option::termsChanged() {
+        ++version;
+        if (asset) {
+            ++asset->optionTermsVersion;
+        }
     }
 
     std::string Option::typeToString() const {
         return (type == OptionType::Call) ? "Call" : "Put";
     }
 
+    std::string Option::getId() const {
+        if (!id.empty()) {
+            return id;
+        }
+        std::ostringstream description;
+        description << asset->getId() << ' ' << typeToString() << ' ' << strikePrice << ' ' << timeToExpiry;
+        return description.str();
+    }
+
+    void Option::setId(std::string newId) {
+        id = std::move(newId);
+    }
+
 } // namespace OptionLib
\ No newline at end of file
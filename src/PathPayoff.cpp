@@ -0,0 +1,173 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/PathPayoff.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace OptionLib {
+
+    PathPayoff::PathPayoff(std::size_t numObservations)
+        : numObservations(numObservations) {
+        if (numObservations == 0) {
+            throw std::invalid_argument("A path-dependent payoff needs at least one monitoring date.");
+        }
+    }
+
+    std::size_t PathPayoff::getNumObservations() const {
+        return numObservations;
+    }
+
+    // AsianPayoff
+
+    AsianPayoff::AsianPayoff(Averaging averaging, std::size_t numObservations)
+        : PathPayoff(numObservations), averaging(averaging) {}
+
+    Averaging AsianPayoff::getAveraging() const {
+        return averaging;
+    }
+
+    std::size_t AsianPayoff::stateSize() const {
+        return 1;
+    }
+
+    std::string AsianPayoff::name() const {
+        return averaging == Averaging::Arithmetic ? "Arithmetic Asian" : "Geometric Asian";
+    }
+
+    void AsianPayoff::start(double, std::size_t count, double* state) const {
+        std::fill(state, state + count, 0.0);
+    }
+
+    void AsianPayoff::observe(const PathObservation& observation, double* state) const {
+        if (averaging == Averaging::Arithmetic) {
+            for (std::size_t i = 0; i < observation.count; ++i) {
+                state[i] += observation.current[i];
+            }
+        } else {
+            for (std::size_t i = 0; i < observation.count; ++i) {
+                state[i] += std::log(observation.current[i]);
+            }
+        }
+    }
+
+    void AsianPayoff::settle(double strike, OptionType type, std::size_t count, const double*,
+                             const double* state, double* payoff) const {
+        const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+        const double n = static_cast<double>(getNumObservations());
+        for (std::size_t i = 0; i < count; ++i) {
+            double average = (averaging == Averaging::Arithmetic) ? state[i] / n : std::exp(state[i] / n);
+            payoff[i] = std::max(phi * (average - strike), 0.0);
+        }
+    }
+
+    // BarrierPayoff
+
+    BarrierPayoff::BarrierPayoff(BarrierType barrierType, double barrier, std::size_t numObservations)
+        : PathPayoff(numObservations), barrierType(barrierType), barrier(barrier) {
+        if (barrier <= 0) {
+            throw std::invalid_argument("Barrier level must be positive.");
+        }
+    }
+
+    BarrierType BarrierPayoff::getBarrierType() const {
+        return barrierType;
+    }
+
+    double BarrierPayoff::getBarrier() const {
+        return barrier;
+    }
+
+    std::size_t BarrierPayoff::stateSize() const {
+        return 1;
+    }
+
+    std::string BarrierPayoff::name() const {
+        switch (barrierType) {
+            case BarrierType::UpAndOut:   return "Up-and-out barrier";
+            case BarrierType::UpAndIn:    return "Up-and-in barrier";
+            case BarrierType::DownAndOut: return "Down-and-out barrier";
+            case BarrierType::DownAndIn:  return "Down-and-in barrier";
+        }
+        return "Barrier";
+    }
+
+    // The state is the probability that the path has not touched the barrier so far
+    void BarrierPayoff::start(double, std::size_t count, double* state) const {
+        std::fill(state, state + count, 1.0);
+    }
+
+    void BarrierPayoff::observe(const PathObservation& observation, double* state) const {
+        const bool up = (barrierType == BarrierType::UpAndOut || barrierType == BarrierType::UpAndIn);
+        const double flatVariance = observation.volatility * observation.volatility;
+        for (std::size_t i = 0; i < observation.count; ++i) {
+            double from = observation.previous[i];
+            double to = observation.current[i];
+            double variance = observation.variance ? observation.variance[i] : flatVariance;
+            bool touched = up ? (from >= barrier || to >= barrier) : (from <= barrier || to <= barrier);
+            if (touched) {
+                state[i] = 0.0;
+            } else {
+                state[i] *= -std::expm1(-2.0 / (variance * observation.dt) * std::log(barrier / from) * std::log(barrier / to));
+            }
+        }
+    }
+
+    void BarrierPayoff::settle(double strike, OptionType type, std::size_t count, const double* terminal,
+                               const double* state, double* payoff) const {
+        const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+        const bool knockOut = (barrierType == BarrierType::UpAndOut || barrierType == BarrierType::DownAndOut);
+        for (std::size_t i = 0; i < count; ++i) {
+            double vanilla = std::max(phi * (terminal[i] - strike), 0.0);
+            payoff[i] = vanilla * (knockOut ? state[i] : 1.0 - state[i]);
+        }
+    }
+
+    // LookbackPayoff
+
+    LookbackPayoff::LookbackPayoff(LookbackStrike strike, std::size_t numObservations)
+        : PathPayoff(numObservations), strike(strike) {}
+
+    LookbackStrike LookbackPayoff::getStrike() const {
+        return strike;
+    }
+
+    std::size_t LookbackPayoff::stateSize() const {
+        return 2;
+    }
+
+    std::string LookbackPayoff::name() const {
+        return strike == LookbackStrike::Fixed ? "Fixed-strike lookback" : "Floating-strike lookback";
+    }
+
+    // state[0..count) holds the running minimum, state[count..2 count) the running maximum
+    void LookbackPayoff::start(double spot, std::size_t count, double* state) const {
+        std::fill(state, state + 2 * count, spot);
+    }
+
+    void LookbackPayoff::observe(const PathObservation& observation, double* state) const {
+        double* low = state;
+        double* high = state + observation.count;
+        for (std::size_t i = 0; i < observation.count; ++i) {
+            low[i] = std::min(low[i], observation.current[i]);
+            high[i] = std::max(high[i], observation.current[i]);
+        }
+    }
+
+    void LookbackPayoff::settle(double strikePrice, OptionType type, std::size_t count, const double* terminal,
+                                const double* state, double* payoff) const {
+        const double* low = state;
+        const double* high = state + count;
+        const bool call = (type == OptionType::Call);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (strike == LookbackStrike::Floating) {
+                payoff[i] = call ? terminal[i] - low[i] : high[i] - terminal[i];
+            } else {
+                payoff[i] = call ? std::max(high[i] - strikePrice, 0.0) : std::max(strikePrice - low[i], 0.0);
+            }
+        }
+    }
+
+} // namespace OptionLib
@@ -4,16 +4,29 @@
 
 #include "OptionLib/Portfolio.h"
 #include "OptionLib/models/Model.h" // Include Model to access price method
+#include "OptionLib/models/BlackScholes.h"
+#include "OptionLib/VolSurface.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <random>
-#include <thread>
-#include <future>
 
 namespace OptionLib {
 
-    Portfolio::Portfolio(std::shared_ptr<Models::Model> defaultModel)
-        : defaultModel(std::move(defaultModel)) {}
+    namespace {
+        // Work per task, in units of one closed-form price
+        constexpr double TaskCost = 256.0;
 
-    void Portfolio::addOption(std::shared_ptr<Option> option, std::shared_ptr<Models::Model> model) {
+        // Left to right in item order, whichever threads produced the values
+        double orderedSum(const std::vector<double>& values) {
+            return std::accumulate(values.begin(), values.end(), 0.0);
+        }
+    }
+
+    Portfolio::Portfolio(std::shared_ptr<Models::Model> defaultModel, ExecutionContext context)
+        : defaultModel(std::move(defaultModel)), context(std::move(context)) {}
+
+    void Portfolio::addOption(std::shared_ptr<Option> option, std::shared_ptr<Models::Model> model, double quantity) {
         // Use the provided model or fall back to the default model if none is provided
         if (!model) {
             model = defaultModel;
@@ -24,49 +37,343 @@ namespace OptionLib {
             throw std::invalid_argument("No model provided for option and no default model set.");
         }
 
-        items.emplace_back(std::move(option), std::move(model));
+        // Extend the open task while it stays within budget; expensive items always start a new one
+        const double cost = model->relativeCost();
+        if (taskStarts.empty() || openTaskCost + cost > TaskCost) {
+            taskStarts.push_back(items.size());
+            openTaskCost = 0.0;
+        }
+        openTaskCost += cost;
+
+        const Asset* asset = option->getAsset().get();
+        const auto [position, added] = groupIndex.try_emplace({model.get(), asset}, groups.size());
+        if (added) {
+            groups.push_back(PositionGroup{model.get(), asset});
+            groups.back().assetVersion = asset->getVersion();
+            groups.back().optionTermsVersion = asset->getOptionTermsVersion();
+        }
+        PositionGroup& group = groups[position->second];
+        group.strikes.push_back(option->getStrikePrice());
+        group.expiries.push_back(option->getTimeToExpiry());
+        group.types.push_back(option->getType());
+        group.quantities.push_back(quantity);
+        group.options.push_back(option.get());
+        group.items.push_back(items.size());
+        group.optionVersions.push_back(option->getVersion());
+
+        items.push_back(PortfolioItem{std::move(option), std::move(model), quantity, position->second, group.items.size() - 1});
+
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.entries.emplace_back();
     }
 
-    double Portfolio::totalValue() const {
-        double total = 0.0;
-        for (const auto& item : items) {
-            total += item.model->price(*item.option);
+    void Portfolio::forEachItem(const std::function<void(std::size_t)>& body) const {
+        // Models that parallelise internally share the same pool
+        context.parallelFor(0, taskStarts.size(), 1, [&](std::size_t firstTask, std::size_t lastTask) {
+            const std::size_t end = (lastTask < taskStarts.size()) ? taskStarts[lastTask] : items.size();
+            for (std::size_t i = taskStarts[firstTask]; i < end; ++i) {
+                body(i);
+            }
+        });
+    }
+
+    std::vector<double> Portfolio::itemValues(const std::function<double(const PortfolioItem&)>& value) const {
+        std::vector<double> values(items.size());
+        forEachItem([&](std::size_t i) {
+            values[i] = value(items[i]);
+        });
+        return values;
+    }
+
+    void Portfolio::refreshGroups() const {
+        auto empty = [&](std::size_t i) {
+            cache.entries[i] = CachedValuation{cache.entries[i].generation + 1};
+        };
+        for (PositionGroup& group : groups) {
+            const std::uint64_t termsVersion = group.asset->getOptionTermsVersion();
+            if (termsVersion != group.optionTermsVersion) {
+                for (std::size_t row = 0; row < group.items.size(); ++row) {
+                    const Option& option = *group.options[row];
+                    if (option.getVersion() != group.optionVersions[row]) {
+                        group.strikes[row] = option.getStrikePrice();
+                        group.expiries[row] = option.getTimeToExpiry();
+                        group.types[row] = option.getType();
+                        group.optionVersions[row] = option.getVersion();
+                        empty(group.items[row]);
+                    }
+                }
+                group.optionTermsVersion = termsVersion;
+            }
+            const std::uint64_t assetVersion = group.asset->getVersion();
+            if (assetVersion != group.assetVersion) {
+                for (std::size_t i : group.items) {
+                    empty(i);
+                }
+                group.assetVersion = assetVersion;
+            }
         }
-        return total;
     }
 
-    double Portfolio::totalGreek(Models::GreekType greekType) const {
-        double total = 0.0;
-        for (const auto& item : items) {
-            total += item.model->computeGreek(*item.option, greekType);
+    std::vector<double> Portfolio::cachedPrices() const {
+        std::vector<double> prices(items.size());
+        StaleRows stale;
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            refreshGroups();
+            for (std::size_t g = 0; g < groups.size(); ++g) {
+                const PositionGroup& group = groups[g];
+                const std::size_t rowsPerTask = group.model->pricesWholeBatches()
+                    ? group.items.size()
+                    : static_cast<std::size_t>(std::max(1.0, TaskCost / group.model->relativeCost()));
+                for (std::size_t row = 0; row < group.items.size(); ++row) {
+                    const std::size_t i = group.items[row];
+                    const CachedValuation& entry = cache.entries[i];
+                    if (entry.hasPrice) {
+                        prices[i] = entry.price;
+                        continue;
+                    }
+                    const std::size_t k = stale.items.size();
+                    if (stale.batches.empty() || stale.batches.back().group != g ||
+                        stale.batches.back().end - stale.batches.back().begin == rowsPerTask) {
+                        stale.batches.push_back({g, k, k});
+                    }
+                    ++stale.batches.back().end;
+                    stale.items.push_back(i);
+                    stale.generations.push_back(entry.generation);
+                    stale.strikes.push_back(group.strikes[row]);
+                    stale.expiries.push_back(group.expiries[row]);
+                    stale.types.push_back(group.types[row]);
+                    stale.options.push_back(group.options[row]);
+                }
+            }
         }
-        return total;
+        if (stale.items.empty()) {
+            return prices;
+        }
+
+        std::vector<double> computed(stale.items.size());
+        context.parallelFor(0, stale.batches.size(), 1, [&](std::size_t firstBatch, std::size_t lastBatch) {
+            for (std::size_t b = firstBatch; b < lastBatch; ++b) {
+                const StaleRows::Batch& batch = stale.batches[b];
+                const PositionGroup& group = groups[batch.group];
+                const std::size_t n = batch.end - batch.begin;
+                group.model->priceBatch({group.asset,
+                                         std::span(stale.strikes).subspan(batch.begin, n),
+                                         std::span(stale.expiries).subspan(batch.begin, n),
+                                         std::span(stale.types).subspan(batch.begin, n),
+                                         std::span(stale.options).subspan(batch.begin, n)},
+                                        std::span(computed).subspan(batch.begin, n));
+            }
+        });
+
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (std::size_t k = 0; k < stale.items.size(); ++k) {
+            prices[stale.items[k]] = computed[k];
+            CachedValuation& entry = cache.entries[stale.items[k]];
+            if (entry.generation == stale.generations[k]) {
+                entry.price = computed[k];
+                entry.hasPrice = true;
+            }
+        }
+        return prices;
     }
 
-    std::vector<double> Portfolio::greekVector(Models::GreekType greekType) const {
-        std::vector<double> values;
-        values.reserve(items.size()); // Reserve memory for efficiency
+    std::vector<Models::Greeks> Portfolio::cachedGreeks(Models::GreekMask mask, bool withPrices) const {
+        constexpr Models::GreekType greekTypes[] = {Models::GreekType::Delta, Models::GreekType::Gamma,
+                                                    Models::GreekType::Vega, Models::GreekType::Theta,
+                                                    Models::GreekType::Rho};
+        const std::size_t n = items.size();
+        std::vector<Models::Greeks> greeks(n);
+        std::vector<Models::GreekMask> missing(n, 0);
+        std::vector<std::uint64_t> generations(n);
+        std::vector<bool> needsPrice(n, false);
+        bool anyMissing = false;
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            refreshGroups();
+            for (std::size_t i = 0; i < n; ++i) {
+                const CachedValuation& entry = cache.entries[i];
+                greeks[i] = entry.greeks;
+                generations[i] = entry.generation;
+                missing[i] = mask & ~entry.knownGreeks;
+                needsPrice[i] = withPrices && missing[i] && !entry.hasPrice;
+                anyMissing = anyMissing || missing[i];
+            }
+        }
+
+        if (anyMissing) {
+            std::vector<double> prices(n);
+            forEachItem([&](std::size_t i) {
+                if (!missing[i]) {
+                    return;
+                }
+                const PortfolioItem& item = items[i];
+                Models::Greeks computed;
+                if (needsPrice[i]) {
+                    const Models::Valuation valuation = item.model->priceWithGreeks(*item.option, missing[i]);
+                    prices[i] = valuation.price;
+                    computed = valuation.greeks;
+                } else {
+                    computed = item.model->computeGreeks(*item.option, missing[i]);
+                }
+                for (Models::GreekType type : greekTypes) {
+                    if (missing[i] & Models::greekBit(type)) {
+                        greeks[i].set(type, computed.get(type));
+                    }
+                }
+            });
+
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            for (std::size_t i = 0; i < n; ++i) {
+                CachedValuation& entry = cache.entries[i];
+                if (!missing[i] || entry.generation != generations[i]) {
+                    continue;
+                }
+                for (Models::GreekType type : greekTypes) {
+                    if (missing[i] & Models::greekBit(type)) {
+                        entry.greeks.set(type, greeks[i].get(type));
+                    }
+                }
+                entry.knownGreeks |= missing[i];
+                if (needsPrice[i] && !entry.hasPrice) {
+                    entry.price = prices[i];
+                    entry.hasPrice = true;
+                }
+            }
+        }
+
+        // Only the requested Greeks, as computeGreeks would return them
+        for (Models::Greeks& row : greeks) {
+            for (Models::GreekType type : greekTypes) {
+                if (!(mask & Models::greekBit(type))) {
+                    row.set(type, 0.0);
+                }
+            }
+        }
+        return greeks;
+    }
 
-        for (const auto& item : items) {
-            values.push_back(item.model->computeGreek(*item.option, greekType));
+    std::vector<double> Portfolio::positionValues() const {
+        std::vector<double> values = cachedPrices();
+        for (const PositionGroup& group : groups) {
+            for (std::size_t row = 0; row < group.items.size(); ++row) {
+                values[group.items[row]] *= group.quantities[row];
+            }
         }
         return values;
     }
 
-    double Portfolio::VaR(double confidenceLevel, double holdingPeriod) const {
-        double portfolioVaR = 0.0;
-        for (const auto& item : items) {
-            portfolioVaR += item.model->VaR(*item.option, confidenceLevel, holdingPeriod);
+    double Portfolio::totalValue() const {
+        return orderedSum(positionValues());
+    }
+
+    double Portfolio::totalGreek(Models::GreekType greekType) const {
+        return orderedSum(greekVector(greekType));
+    }
+
+    std::vector<double> Portfolio::greekVector(Models::GreekType greekType) const {
+        const std::vector<Models::Greeks> greeks = cachedGreeks(Models::greekBit(greekType));
+        std::vector<double> values(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            values[i] = items[i].quantity * greeks[i].get(greekType);
         }
-        return portfolioVaR;
+        return values;
+    }
+
+    std::vector<Models::Greeks> Portfolio::greekMatrix(Models::GreekMask mask) const {
+        std::vector<Models::Greeks> rows = cachedGreeks(mask);
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            for (Models::GreekType type : {Models::GreekType::Delta, Models::GreekType::Gamma, Models::GreekType::Vega,
+                                           Models::GreekType::Theta, Models::GreekType::Rho}) {
+                rows[i].set(type, items[i].quantity * rows[i].get(type));
+            }
+        }
+        return rows;
+    }
+
+    double Portfolio::VaR(double confidenceLevel, double holdingPeriod) const {
+        return orderedSum(itemValues([=](const PortfolioItem& item) {
+            return std::abs(item.quantity) * item.model->VaR(*item.option, confidenceLevel, holdingPeriod);
+        }));
     }
 
     double Portfolio::ExpectedShortfall(double confidenceLevel, double holdingPeriod) const {
-        double portfolioES = 0.0;
-        for (const auto& item : items) {
-            portfolioES += item.model->ExpectedShortfall(*item.option, confidenceLevel, holdingPeriod);
+        return orderedSum(itemValues([=](const PortfolioItem& item) {
+            return std::abs(item.quantity) * item.model->ExpectedShortfall(*item.option, confidenceLevel, holdingPeriod);
+        }));
+    }
+
+    Portfolio::RiskReport Portfolio::riskReport(const ReportRequest& request) const {
+        constexpr Models::GreekType greekTypes[] = {Models::GreekType::Delta, Models::GreekType::Gamma,
+                                                    Models::GreekType::Vega, Models::GreekType::Theta,
+                                                    Models::GreekType::Rho};
+        RiskReport report;
+        report.positions.resize(items.size());
+
+        // Items missing both get their price and Greeks from one evaluation, and the price is
+        // cached, so totalValue reads the same number; the remaining prices are batched
+        const std::vector<Models::Greeks> greeks =
+            request.greeks ? cachedGreeks(request.greeks, true) : std::vector<Models::Greeks>(items.size());
+        const std::vector<double> prices = cachedPrices();
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            PositionRisk& position = report.positions[i];
+            position.quantity = items[i].quantity;
+            position.value = items[i].quantity * prices[i];
+            for (Models::GreekType type : greekTypes) {
+                position.greeks.set(type, items[i].quantity * greeks[i].get(type));
+            }
+        }
+
+        // VaR and ES from the prices above and each option's volatility, whatever its model;
+        // positions whose asset has no volatility are flagged instead
+        if (request.valueAtRisk) {
+            for (std::size_t i = 0; i < items.size(); ++i) {
+                const Option& option = *items[i].option;
+                const VolSurface* surface = nullptr;
+                const MarketSnapshot market = option.getAsset()->snapshot(surface);
+                if (!surface && !market.has(Param::volatility)) {
+                    continue;
+                }
+                const double volatility = surface ? surface->volatility(option.getStrikePrice(), option.getTimeToExpiry())
+                                                  : market.get(Param::volatility);
+                const double scale = std::abs(items[i].quantity);
+                PositionRisk& position = report.positions[i];
+                position.VaR = scale * Models::BlackScholes::lognormalVaR(prices[i], volatility, request.confidenceLevel,
+                                                                          request.holdingPeriod);
+                position.expectedShortfall = scale * Models::BlackScholes::lognormalExpectedShortfall(
+                    prices[i], volatility, request.confidenceLevel, request.holdingPeriod);
+                position.hasValueAtRisk = true;
+            }
+        }
+
+        // Totals in item order, as for the individual queries
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            PositionRisk& position = report.positions[i];
+            position.id = items[i].option->getId();
+            report.totalValue += position.value;
+            for (Models::GreekType type : greekTypes) {
+                report.totalGreeks.set(type, report.totalGreeks.get(type) + position.greeks.get(type));
+            }
+            report.VaR += position.VaR;
+            report.expectedShortfall += position.expectedShortfall;
+        }
+        if (request.concentration) {
+            for (PositionRisk& position : report.positions) {
+                position.share = position.value / report.totalValue;
+            }
+        }
+        return report;
+    }
+
+    Portfolio::RiskReport Portfolio::riskReport() const {
+        return riskReport(ReportRequest{});
+    }
+
+    void Portfolio::invalidateCache() {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (CachedValuation& entry : cache.entries) {
+            entry = CachedValuation{entry.generation + 1};
         }
-        return portfolioES;
     }
 
     // std::map<std::string, double> Portfolio::sensitivityAnalysis(double spotChange, double volatilityChange) const {
@@ -94,12 +401,11 @@ namespace OptionLib {
 
     std::map<std::string, double> Portfolio::concentrationMeasures() const {
         std::map<std::string, double> concentrations;
-        double totalValue = this->totalValue();
+        const std::vector<double> values = positionValues();
+        const double totalValue = orderedSum(values);
 
-        int index = 1;
-        for (const auto& item : items) {
-            double itemValue = item.model->price(*item.option);
-            concentrations["Option_" + std::to_string(index++)] = itemValue / totalValue;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            concentrations["Option_" + std::to_string(i + 1)] = values[i] / totalValue;
         }
 
         return concentrations;
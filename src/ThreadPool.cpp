@@ -0,0 +1,205 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/ThreadPool.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace OptionLib {
+
+    namespace {
+
+        // Identifies the pool (and queue) the current thread works for, if any
+        thread_local const ThreadPool* currentPool = nullptr;
+        thread_local int currentQueue = -1;
+
+        std::mutex globalMutex;
+        std::shared_ptr<ThreadPool> globalPool;
+
+        void pinToCpu(std::thread& thread, int cpu) {
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#else
+            (void)thread;
+            (void)cpu;
+#endif
+        }
+
+    } // namespace
+
+    struct ThreadPool::TaskGroup {
+        std::atomic<std::size_t> remaining{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    ThreadPool::ThreadPool(unsigned int numThreads, std::vector<int> cpuAffinity) {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (unsigned int i = 0; i < numThreads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+            if (!cpuAffinity.empty()) {
+                pinToCpu(workers.back(), cpuAffinity[i % cpuAffinity.size()]);
+            }
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    unsigned int ThreadPool::size() const {
+        return static_cast<unsigned int>(workers.size());
+    }
+
+    void ThreadPool::push(Task task) {
+        // Workers keep nested work on their own deque; outside threads spread it round-robin
+        std::size_t index = (currentPool == this)
+            ? static_cast<std::size_t>(currentQueue)
+            : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            queuedTasks.fetch_add(1);
+        }
+        wakeUp.notify_one();
+    }
+
+    bool ThreadPool::tryRunOne(int preferredQueue) {
+        Task task;
+        bool found = false;
+
+        if (preferredQueue >= 0) {
+            auto& own = *queues[preferredQueue];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                found = true;
+            }
+        }
+
+        const std::size_t start = preferredQueue >= 0 ? static_cast<std::size_t>(preferredQueue) + 1 : 0;
+        for (std::size_t k = 0; !found && k < queues.size(); ++k) {
+            auto& victim = *queues[(start + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                found = true;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+        queuedTasks.fetch_sub(1);
+        task.run();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(unsigned int index) {
+        currentPool = this;
+        currentQueue = static_cast<int>(index);
+
+        while (true) {
+            if (tryRunOne(currentQueue)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+            if (stopping && queuedTasks.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                                 const std::function<void(std::size_t, std::size_t)>& body) {
+        if (begin >= end) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t numChunks = (end - begin + grain - 1) / grain;
+        if (numChunks == 1) {
+            body(begin, end);
+            return;
+        }
+
+        auto group = std::make_shared<TaskGroup>();
+        group->remaining.store(numChunks);
+
+        for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+            std::size_t chunkBegin = begin + chunk * grain;
+            std::size_t chunkEnd = std::min(end, chunkBegin + grain);
+            push(Task{[group, &body, chunkBegin, chunkEnd] {
+                try {
+                    body(chunkBegin, chunkEnd);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(group->mutex);
+                    if (!group->error) {
+                        group->error = std::current_exception();
+                    }
+                }
+                if (group->remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(group->mutex);
+                    group->done.notify_all();
+                }
+            }});
+        }
+
+        // Help out rather than block, so a waiting worker never idles while work is queued
+        const int self = (currentPool == this) ? currentQueue : -1;
+        while (group->remaining.load() > 0) {
+            if (tryRunOne(self)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(group->mutex);
+            group->done.wait_for(lock, std::chrono::microseconds(200), [&] { return group->remaining.load() == 0; });
+        }
+
+        if (group->error) {
+            std::rethrow_exception(group->error);
+        }
+    }
+
+    std::shared_ptr<ThreadPool> ThreadPool::global() {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        if (!globalPool) {
+            globalPool = std::make_shared<ThreadPool>();
+        }
+        return globalPool;
+    }
+
+    void ThreadPool::configureGlobal(unsigned int numThreads, std::vector<int> cpuAffinity) {
+        auto pool = std::make_shared<ThreadPool>(numThreads, std::move(cpuAffinity));
+        std::lock_guard<std::mutex> lock(globalMutex);
+        globalPool = std::move(pool);
+    }
+
+} // namespace OptionLib
@@ -0,0 +1,230 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/VolSurface.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace OptionLib {
+
+    struct VolSurface::Slice {
+        double expiry = 0.0;
+        std::vector<double> logStrikes;
+        std::vector<double> variances;      // total variance at each log-strike
+        std::vector<double> slopes;         // dw/dk at each log-strike
+
+        // Index table: buckets[b] is the interval holding the start of bucket b, so a lookup
+        // starts at most a step or two short of its interval
+        double bucketScale = 0.0;
+        std::vector<std::uint32_t> buckets;
+    };
+
+    namespace {
+
+        // Lee's moment formula bounds the wings' total-variance slope by 2
+        constexpr double MaxWingSlope = 2.0;
+        constexpr double CalendarTolerance = 1e-12;
+        constexpr std::size_t BucketsPerInterval = 2;
+
+        bool byExpiryThenStrike(const VolatilityQuote& a, const VolatilityQuote& b) {
+            return a.expiry < b.expiry || (a.expiry == b.expiry && a.strike < b.strike);
+        }
+
+    } // namespace
+
+    VolSurface::VolSurface(std::span<const VolatilityQuote> quotes) {
+        update(quotes);
+    }
+
+    std::shared_ptr<const VolSurface::Slice> VolSurface::buildSlice(double expiry, std::span<const VolatilityQuote> quotes) {
+        auto slice = std::make_shared<Slice>();
+        slice->expiry = expiry;
+        const std::size_t n = quotes.size();
+        slice->logStrikes.reserve(n);
+        slice->variances.reserve(n);
+        for (const VolatilityQuote& quote : quotes) {
+            if (!(quote.strike > 0.0) || !(quote.impliedVolatility >= 0.0) || !std::isfinite(quote.impliedVolatility)) {
+                throw std::invalid_argument("Volatility quotes need positive strikes and non-negative volatilities.");
+            }
+            const double k = std::log(quote.strike);
+            if (!slice->logStrikes.empty() && k <= slice->logStrikes.back()) {
+                throw std::invalid_argument("Two volatility quotes share a strike and expiry.");
+            }
+            slice->logStrikes.push_back(k);
+            slice->variances.push_back(quote.impliedVolatility * quote.impliedVolatility * expiry);
+        }
+
+        // Fritsch-Carlson slopes: the weighted harmonic mean of the neighbouring secants, and zero
+        // at local extrema, so the cubic never overshoots the quotes
+        const std::vector<double>& k = slice->logStrikes;
+        const std::vector<double>& w = slice->variances;
+        slice->slopes.assign(n, 0.0);
+        if (n == 1) {
+            return slice;
+        }
+        std::vector<double> secants(n - 1);
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            secants[i] = (w[i + 1] - w[i]) / (k[i + 1] - k[i]);
+        }
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            if (secants[i - 1] * secants[i] > 0.0) {
+                const double hLeft = k[i] - k[i - 1], hRight = k[i + 1] - k[i];
+                const double wLeft = 2.0 * hRight + hLeft, wRight = hRight + 2.0 * hLeft;
+                slice->slopes[i] = (wLeft + wRight) / (wLeft / secants[i - 1] + wRight / secants[i]);
+            }
+        }
+        // The wings continue with the end slopes, which must rise away from the quotes
+        slice->slopes.front() = std::clamp(secants.front(), -MaxWingSlope, 0.0);
+        slice->slopes.back() = std::clamp(secants.back(), 0.0, MaxWingSlope);
+
+        const std::size_t numBuckets = BucketsPerInterval * (n - 1);
+        slice->bucketScale = static_cast<double>(numBuckets) / (k.back() - k.front());
+        slice->buckets.resize(numBuckets);
+        std::size_t interval = 0;
+        for (std::size_t b = 0; b < numBuckets; ++b) {
+            const double start = k.front() + static_cast<double>(b) / slice->bucketScale;
+            while (interval + 2 < n && k[interval + 1] <= start) {
+                ++interval;
+            }
+            slice->buckets[b] = static_cast<std::uint32_t>(interval);
+        }
+        return slice;
+    }
+
+    double VolSurface::sliceVariance(const Slice& slice, double k) {
+        const std::vector<double>& ks = slice.logStrikes;
+        const std::vector<double>& w = slice.variances;
+        const std::size_t n = ks.size();
+        if (n == 1) {
+            return w.front();
+        }
+        if (k <= ks.front()) {
+            return w.front() + slice.slopes.front() * (k - ks.front());
+        }
+        if (k >= ks.back()) {
+            return w.back() + slice.slopes.back() * (k - ks.back());
+        }
+
+        const auto bucket = std::min(static_cast<std::size_t>((k - ks.front()) * slice.bucketScale), slice.buckets.size() - 1);
+        std::size_t i = slice.buckets[bucket];
+        while (k > ks[i + 1]) {
+            ++i;
+        }
+
+        // Cubic Hermite interpolation on [k_i, k_{i+1}]
+        const double h = ks[i + 1] - ks[i];
+        const double t = (k - ks[i]) / h;
+        const double t2 = t * t, t3 = t2 * t;
+        return (2.0 * t3 - 3.0 * t2 + 1.0) * w[i] + (t3 - 2.0 * t2 + t) * h * slice.slopes[i]
+             + (3.0 * t2 - 2.0 * t3) * w[i + 1] + (t3 - t2) * h * slice.slopes[i + 1];
+    }
+
+    void VolSurface::checkCalendar(std::size_t index) const {
+        auto check = [this](std::size_t earlier) {
+            const Slice& near = *slices[earlier];
+            const Slice& far = *slices[earlier + 1];
+            for (const Slice* nodes : {&near, &far}) {
+                for (double k : nodes->logStrikes) {
+                    const double wNear = sliceVariance(near, k), wFar = sliceVariance(far, k);
+                    if (wFar < wNear - CalendarTolerance * std::max(wNear, 1.0)) {
+                        throw std::invalid_argument("Total variance falls between expiries " + std::to_string(near.expiry) +
+                                                    " and " + std::to_string(far.expiry) + " at strike " +
+                                                    std::to_string(std::exp(k)) + " (calendar arbitrage).");
+                    }
+                }
+            }
+        };
+        if (index > 0) {
+            check(index - 1);
+        }
+        if (index + 1 < slices.size()) {
+            check(index);
+        }
+    }
+
+    void VolSurface::update(std::span<const VolatilityQuote> quotes) {
+        std::vector<VolatilityQuote> sorted(quotes.begin(), quotes.end());
+        std::sort(sorted.begin(), sorted.end(), byExpiryThenStrike);
+
+        // Build the new slices on a copy, so a rejected update leaves the surface unchanged
+        VolSurface next = *this;
+        std::vector<double> changed;
+        for (std::size_t begin = 0; begin < sorted.size();) {
+            const double expiry = sorted[begin].expiry;
+            if (!(expiry > 0.0)) {
+                throw std::invalid_argument("Time to expiry must be positive.");
+            }
+            std::size_t end = begin;
+            while (end < sorted.size() && sorted[end].expiry == expiry) {
+                ++end;
+            }
+
+            std::shared_ptr<const Slice> slice = buildSlice(expiry, std::span(sorted).subspan(begin, end - begin));
+            const auto position = std::lower_bound(next.expiries.begin(), next.expiries.end(), expiry);
+            const auto index = static_cast<std::size_t>(position - next.expiries.begin());
+            if (position != next.expiries.end() && *position == expiry) {
+                next.slices[index] = std::move(slice);
+            } else {
+                next.expiries.insert(position, expiry);
+                next.slices.insert(next.slices.begin() + static_cast<std::ptrdiff_t>(index), std::move(slice));
+            }
+            changed.push_back(expiry);
+            begin = end;
+        }
+
+        for (double expiry : changed) {
+            next.checkCalendar(static_cast<std::size_t>(
+                std::lower_bound(next.expiries.begin(), next.expiries.end(), expiry) - next.expiries.begin()));
+        }
+        *this = std::move(next);
+    }
+
+    void VolSurface::removeExpiry(double expiry) {
+        const auto position = std::lower_bound(expiries.begin(), expiries.end(), expiry);
+        if (position == expiries.end() || *position != expiry) {
+            throw std::invalid_argument("The surface has no slice at this expiry.");
+        }
+        slices.erase(slices.begin() + (position - expiries.begin()));
+        expiries.erase(position);
+    }
+
+    double VolSurface::totalVariance(double strike, double expiry) const {
+        if (slices.empty()) {
+            throw std::runtime_error("Volatility surface has no quotes.");
+        }
+        if (!(strike > 0.0) || !(expiry > 0.0)) {
+            throw std::invalid_argument("Strike and expiry must be positive.");
+        }
+        const double k = std::log(strike);
+
+        // Expiries are few, so a binary search is as quick as a table
+        const auto after = std::upper_bound(expiries.begin(), expiries.end(), expiry);
+        if (after == expiries.begin()) {
+            return sliceVariance(*slices.front(), k) * expiry / expiries.front();
+        }
+        if (after == expiries.end()) {
+            return sliceVariance(*slices.back(), k) * expiry / expiries.back();
+        }
+        const auto i = static_cast<std::size_t>(after - expiries.begin()) - 1;
+        const double weight = (expiry - expiries[i]) / (expiries[i + 1] - expiries[i]);
+        const double wNear = sliceVariance(*slices[i], k);
+        return wNear + weight * (sliceVariance(*slices[i + 1], k) - wNear);
+    }
+
+    double VolSurface::volatility(double strike, double expiry) const {
+        return std::sqrt(totalVariance(strike, expiry) / expiry);
+    }
+
+    const std::vector<double>& VolSurface::getExpiries() const {
+        return expiries;
+    }
+
+    bool VolSurface::empty() const {
+        return slices.empty();
+    }
+
+} // namespace OptionLib
@@ -3,120 +3,337 @@
 //
 
 #include <OptionLib/models/Binomial.h>
+#include <OptionLib/models/BlackScholes.h>
+#include <array>
 #include <cmath>
-#include <future>
 #include <vector>
 #include <algorithm>
 #include <numeric>
 
 namespace OptionLib::Models {
 
-    double Binomial::priceWrapper(const Option &_option, double _spotPrice, double _riskFreeRate, double _volatility, double _strikePrice, double _timeToMaturity, int _numSteps) {
-        double dt = _timeToMaturity / _numSteps;
-        double u = std::exp(_volatility * std::sqrt(dt));
-        double d = 1.0 / u;
-        double p = (std::exp(_riskFreeRate * dt) - d) / (u - d);
-        double discountFactor = std::exp(-_riskFreeRate * dt);
-
-        unsigned int numThreads = std::thread::hardware_concurrency();
-        if (numThreads == 0) numThreads = 2;
-
-        int nodesPerThread = (_numSteps + 1) / numThreads;
-        int remainingNodes = (_numSteps + 1) % numThreads;
-
-        std::vector<double> optionValues(_numSteps + 1);
-        std::vector<double> assetPrices(_numSteps + 1);
-
-        auto payoffCalculator = [&](int start, int end) {
-            for (int i = start; i < end; ++i) {
-                double assetPrice = _spotPrice * std::pow(u, _numSteps - i) * std::pow(d, i);
-                assetPrices[i] = assetPrice;
-                optionValues[i] = (_option.getType() == OptionType::Call) ?
-                                   std::max(assetPrice - _strikePrice, 0.0) :
-                                   std::max(_strikePrice - assetPrice, 0.0);
+    Binomial::Binomial(ExecutionContext context)
+        : Model(std::move(context)) {}
+
+    Binomial::Binomial(Settings settings, ExecutionContext context)
+        : Model(std::move(context)), settings(settings) {}
+
+    namespace {
+
+        // Backward induction runs in bands of TileHeight time steps. Within a band each tile of
+        // TileWidth nodes copies its nodes plus the TileHeight nodes to its right (the halo it
+        // depends on) into a local buffer and steps them down the band there, so tiles share no
+        // writes and need no synchronisation until the band ends. The halo costs about
+        // TileHeight / (2 TileWidth) of redundant work; the buffer stays in L1/L2.
+        constexpr std::size_t TileWidth = 1024;
+        constexpr std::size_t TileHeight = 64;
+
+        // Node values below this are flushed to zero so deep out-of-the-money nodes never decay
+        // into denormals, which are several times slower to multiply
+        constexpr double NegligibleValue = 1e-250;
+
+        // Largest |ln| of a node's spot relative to the drifted spot; beyond it the tree is clamped
+        constexpr double MaxLogLevel = 600.0;
+
+        // Fewest steps of the finer tree; the coarser tree of a Richardson pair still has steps
+        // 1 and 2 to read the tree Greeks from, even with smoothing
+        constexpr int MinTreeSteps = 8;
+
+        // Step counts tried when a target accuracy is set
+        constexpr int MinAdaptiveSteps = 32;
+        constexpr int MaxAdaptiveSteps = 1 << 15;
+
+        // Steps at which the holder may exercise before expiry
+        std::vector<char> exerciseSteps(const Option& option, double timeToMaturity, int numSteps) {
+            std::vector<char> steps(numSteps + 1, 0);
+            if (option.getExerciseStyle() == ExerciseStyle::American) {
+                std::fill(steps.begin(), steps.end(), 1);
+            } else if (option.getExerciseStyle() == ExerciseStyle::Bermudan) {
+                for (double date : option.getExerciseDates()) {
+                    if (date <= timeToMaturity) {
+                        steps[static_cast<std::size_t>(std::lround(date / timeToMaturity * numSteps))] = 1;
+                    }
+                }
             }
-        };
+            return steps;
+        }
+
+        // Peizer-Pratt inversion (method 2): the binomial probability whose n-step tail matches
+        // the normal tail beyond z
+        double peizerPratt(double z, int n) {
+            const double ratio = z / (n + 1.0 / 3.0 + 0.1 / (n + 1.0));
+            return 0.5 + std::copysign(0.5, z) * std::sqrt(1.0 - std::exp(-ratio * ratio * (n + 1.0 / 6.0)));
+        }
 
-        std::vector<std::future<void>> futures;
-        int start = 0;
-        for (unsigned int i = 0; i < numThreads; ++i) {
-            int end = start + nodesPerThread + (i < remainingNodes ? 1 : 0);
-            futures.push_back(std::async(std::launch::async, payoffCalculator, start, end));
-            start = end;
+        // Leisen-Reimer trees need an odd number of steps
+        int stepsFor(Lattice lattice, int numSteps) {
+            numSteps = std::max(numSteps, 1);
+            return (lattice == Lattice::LeisenReimer) ? (numSteps | 1) : numSteps;
         }
 
-        for (auto& future : futures) {
-            future.get();
+        // The coarser tree of a Richardson pair: about half the steps
+        int coarseStepsFor(Lattice lattice, int numSteps) {
+            return stepsFor(lattice, std::max(numSteps / 2, MinTreeSteps / 2));
         }
 
-        for (int step = _numSteps - 1; step >= 0; --step) {
-            for (int i = 0; i <= step; ++i) {
-                optionValues[i] = discountFactor * (p * optionValues[i] + (1.0 - p) * optionValues[i + 1]);
+        // Cancels the leading c / N^k error term of two trees, in the price and each tree Greek:
+        // k = 2 for European options on Leisen-Reimer trees, otherwise 1 (early exercise costs
+        // Leisen-Reimer its second order)
+        Valuation extrapolate(int order, int fineSteps, const Valuation& fineValue, int coarseSteps, const Valuation& coarseValue) {
+            const double fine = std::pow(fineSteps, order), coarse = std::pow(coarseSteps, order);
+            auto combine = [&](double fineX, double coarseX) { return (fine * fineX - coarse * coarseX) / (fine - coarse); };
+            Valuation valuation;
+            valuation.price = combine(fineValue.price, coarseValue.price);
+            for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Theta}) {
+                valuation.greeks.set(type, combine(fineValue.greeks.get(type), coarseValue.greeks.get(type)));
             }
-            optionValues.resize(step + 1);
+            return valuation;
+        }
+
+    } // namespace
+
+    Valuation Binomial::treeValuation(const Option &_option, double _spotPrice, double _riskFreeRate, double _volatility, double _strikePrice, double _timeToMaturity, int _numSteps) const {
+        const std::size_t n = static_cast<std::size_t>(_numSteps);
+        double dt = _timeToMaturity / _numSteps;
+        double growth = std::exp(_riskFreeRate * dt);
+        double u, d, p;
+        if (settings.lattice == Lattice::LeisenReimer) {
+            const double volSqrtT = _volatility * std::sqrt(_timeToMaturity);
+            const double d1 = (std::log(_spotPrice / _strikePrice) + _riskFreeRate * _timeToMaturity) / volSqrtT + 0.5 * volSqrtT;
+            p = peizerPratt(d1 - volSqrtT, _numSteps);
+            u = growth * peizerPratt(d1, _numSteps) / p;
+            d = (growth - p * u) / (1.0 - p);
+        } else {
+            u = std::exp(_volatility * std::sqrt(dt));
+            d = 1.0 / u;
+            p = (growth - d) / (u - d);
+        }
+        double discountFactor = 1.0 / growth;
+        const double up = discountFactor * p, down = discountFactor * (1.0 - p);
+        const double sign = (_option.getType() == OptionType::Call) ? 1.0 : -1.0;
+
+        // Node (step, i) has spot S u^(step-i) d^i = driftedSpot[step] * level(step - 2i), where
+        // driftedSpot[step] = S (ud)^(step/2) stays near S e^(rt) and level(j) = (u/d)^(j/2). Both are
+        // exp of their exponents, so nothing underflows against an overflow (0 * inf) on deep
+        // high-volatility trees. Levels are split by the parity of n - j, which makes the levels of
+        // one time step contiguous, and capped at e^(+-MaxLogLevel): nodes that far out carry
+        // no probability at working precision but must stay finite.
+        const double logUp = std::log(u), logDown = std::log(d);
+        std::vector<double> driftedSpot(n + 1);
+        for (std::size_t k = 0; k <= n; ++k) {
+            driftedSpot[k] = _spotPrice * std::exp(0.5 * static_cast<double>(k) * (logUp + logDown));
+        }
+        std::array<std::vector<double>, 2> levelsByParity{std::vector<double>(n + 1), std::vector<double>(n + 1)};
+        for (std::size_t q = 0; q <= 2 * n; ++q) {
+            const double exponent = 0.5 * (static_cast<double>(n) - static_cast<double>(q)) * (logUp - logDown);
+            levelsByParity[q % 2][q / 2] = std::exp(std::clamp(exponent, -MaxLogLevel, MaxLogLevel));
         }
+        // levels(step) + i points at level(step - 2i)
+        auto levels = [&](std::size_t step) {
+            return &levelsByParity[(n - step) % 2][(n - step) / 2];
+        };
+        const std::vector<char> exercisable = exerciseSteps(_option, _timeToMaturity, _numSteps);
+
+        // Values at expiry, or with smoothing the Black-Scholes values one step earlier
+        const std::size_t last = settings.smoothing ? n - 1 : n;
+        std::vector<double> optionValues(last + 1), nextValues(last + 1);
+        const std::size_t numNodes = last + 1;
+        const std::size_t nodesPerChunk = (numNodes + context.concurrency() - 1) / context.concurrency();
+        context.parallelFor(0, numNodes, nodesPerChunk, [&](std::size_t start, std::size_t end) {
+            for (std::size_t i = start; i < end; ++i) {
+                optionValues[i] = std::max(sign * (driftedSpot[last] * levels(last)[i] - _strikePrice), 0.0);
+            }
+            if (settings.smoothing) {
+                const std::size_t count = end - start;
+                std::vector<double> spots(count), strikes(count, _strikePrice), expiries(count, dt),
+                                    vols(count, _volatility), rates(count, _riskFreeRate);
+                std::vector<OptionType> types(count, _option.getType());
+                for (std::size_t i = 0; i < count; ++i) {
+                    spots[i] = driftedSpot[last] * levels(last)[start + i];
+                }
+                std::vector<double> continuation(count);
+                BlackScholes::priceBatch({spots, strikes, expiries, vols, rates, types}, {.price = continuation});
+                for (std::size_t i = 0; i < count; ++i) {
+                    const double intrinsic = exercisable[last] ? optionValues[start + i] : 0.0;
+                    optionValues[start + i] = std::max(continuation[i], intrinsic);
+                }
+            }
+        });
 
-        return optionValues[0];
+        std::array<double, 3> stepTwo{}, stepOne{};
+        for (std::size_t top = last; top > 0;) {
+            const std::size_t height = std::min(TileHeight, top);
+            const std::size_t outputs = top - height + 1;
+            const std::size_t numTiles = (outputs + TileWidth - 1) / TileWidth;
+            context.parallelFor(0, numTiles, 1, [&](std::size_t tileBegin, std::size_t tileEnd) {
+                for (std::size_t tile = tileBegin; tile < tileEnd; ++tile) {
+                    const std::size_t lo = tile * TileWidth;
+                    const std::size_t hi = std::min(lo + TileWidth, outputs);
+                    std::array<double, TileWidth + TileHeight> local;
+                    std::copy(optionValues.begin() + lo, optionValues.begin() + hi + height, local.begin());
+                    for (std::size_t j = 1; j <= height; ++j) {
+                        const std::size_t step = top - j;
+                        const std::size_t width = hi + height - lo - j;
+                        if (exercisable[step]) {
+                            const double base = driftedSpot[step];
+                            const double* ratio = levels(step) + lo;
+                            for (std::size_t i = 0; i < width; ++i) {
+                                const double value = std::max(up * local[i] + down * local[i + 1], sign * (base * ratio[i] - _strikePrice));
+                                local[i] = (value >= NegligibleValue) ? value : 0.0;
+                            }
+                        } else {
+                            for (std::size_t i = 0; i < width; ++i) {
+                                const double value = up * local[i] + down * local[i + 1];
+                                local[i] = (value >= NegligibleValue) ? value : 0.0;
+                            }
+                        }
+                        // Nodes kept for Delta, Gamma and Theta, which all live in the first tile
+                        if (lo == 0 && step == 2) {
+                            std::copy(local.begin(), local.begin() + 3, stepTwo.begin());
+                        } else if (lo == 0 && step == 1) {
+                            std::copy(local.begin(), local.begin() + 2, stepOne.begin());
+                        }
+                    }
+                    std::copy(local.begin(), local.begin() + (hi - lo), nextValues.begin() + lo);
+                }
+            });
+            optionValues.swap(nextValues);
+            top -= height;
+        }
+
+        // Delta and Gamma from the spot differences of steps 1 and 2, Theta from the middle node
+        // of step 2 with a Taylor correction for lattices where it is not at the initial spot
+        Valuation valuation;
+        valuation.price = optionValues[0];
+        auto spotAt = [&](std::size_t step, std::size_t i) { return driftedSpot[step] * levels(step)[i]; };
+        Greeks& greeks = valuation.greeks;
+        greeks.delta = (stepOne[0] - stepOne[1]) / (spotAt(1, 0) - spotAt(1, 1));
+        const double upperDelta = (stepTwo[0] - stepTwo[1]) / (spotAt(2, 0) - spotAt(2, 1));
+        const double lowerDelta = (stepTwo[1] - stepTwo[2]) / (spotAt(2, 1) - spotAt(2, 2));
+        greeks.gamma = (upperDelta - lowerDelta) / (0.5 * (spotAt(2, 0) - spotAt(2, 2)));
+        const double drift = spotAt(2, 1) - _spotPrice;
+        greeks.theta = (stepTwo[1] - valuation.price - greeks.delta * drift - 0.5 * greeks.gamma * drift * drift) / (2.0 * dt);
+        return valuation;
+    }
+
+    Valuation Binomial::valuationWrapper(const Option& option, double spotPrice, double riskFreeRate, double volatility,
+                                         double strikePrice, double timeToMaturity, int& numSteps) const {
+        requireVanilla(option, "Binomial");
+        const Lattice lattice = settings.lattice;
+        const int order = (lattice == Lattice::LeisenReimer && !option.hasEarlyExercise()) ? 2 : 1;
+        auto tree = [&](int steps) {
+            return treeValuation(option, spotPrice, riskFreeRate, volatility, strikePrice, timeToMaturity, steps);
+        };
+
+        if (numSteps > 0 || settings.targetAccuracy <= 0.0) {
+            numSteps = stepsFor(lattice, std::max(numSteps > 0 ? numSteps : settings.numSteps, MinTreeSteps));
+            if (!settings.richardson) {
+                return tree(numSteps);
+            }
+            const int coarseSteps = coarseStepsFor(lattice, numSteps);
+            return extrapolate(order, numSteps, tree(numSteps), coarseSteps, tree(coarseSteps));
+        }
+
+        // Doubles the steps until three successive prices agree, so one chance crossing of the
+        // oscillating error does not end the search. Each round's tree is the coarse tree of the
+        // next round's Richardson pair, so no tree is priced twice.
+        numSteps = stepsFor(lattice, MinAdaptiveSteps);
+        Valuation treeValue = tree(numSteps);
+        Valuation previous = treeValue;
+        if (settings.richardson) {
+            const int coarseSteps = coarseStepsFor(lattice, numSteps);
+            previous = extrapolate(order, numSteps, treeValue, coarseSteps, tree(coarseSteps));
+        }
+        bool agreed = false;
+        while (numSteps < MaxAdaptiveSteps) {
+            const int coarseSteps = numSteps;
+            const Valuation coarseValue = treeValue;
+            numSteps = (lattice == Lattice::LeisenReimer) ? 2 * numSteps + 1 : 2 * numSteps;
+            treeValue = tree(numSteps);
+            const Valuation current = settings.richardson ? extrapolate(order, numSteps, treeValue, coarseSteps, coarseValue)
+                                                          : treeValue;
+            const bool agrees = std::abs(current.price - previous.price) <= settings.targetAccuracy;
+            previous = current;
+            if (agrees && agreed) {
+                break;
+            }
+            agreed = agrees;
+        }
+        return previous;
     }
 
     double Binomial::price(const Option& option) const {
-        auto asset = option.getAsset();
-        double K = option.getStrikePrice();
-        double T = option.getTimeToExpiry();
-        return priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), K, T, static_cast<int>(std::pow(10, 4)));
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        int numSteps = 0;
+        return valuationWrapper(option, market.spotPrice, market.get(Param::riskFreeRate), optionVolatility(option, market, surface),
+                                option.getStrikePrice(), option.getTimeToExpiry(), numSteps).price;
     }
 
-    double Binomial::computeGreek(const Option& option, GreekType greekType) const {
-        switch (greekType) {
-            case GreekType::Delta: return calculateDelta(option);
-            case GreekType::Gamma: return calculateGamma(option);
-            case GreekType::Vega: return calculateVega(option);
-            case GreekType::Theta: return calculateTheta(option);
-            case GreekType::Rho: return calculateRho(option);
-            default:
-                throw std::invalid_argument("Invalid Greek type");
-        }
+    const Binomial::Settings& Binomial::getSettings() const {
+        return settings;
     }
 
-    double Binomial::calculateDelta(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.01 * asset->getSpotPrice();
-        double pricePlus = priceWrapper(option, asset->getSpotPrice() + epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice() - epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        return (pricePlus - priceMinus) / (2 * epsilon);
+    void Binomial::setSettings(const Settings& newSettings) {
+        settings = newSettings;
     }
 
-    double Binomial::calculateGamma(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.01 * asset->getSpotPrice();
-        double pricePlus = priceWrapper(option, asset->getSpotPrice() + epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        double priceCenter = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(),option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice() - epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        return (pricePlus - 2 * priceCenter + priceMinus) / (epsilon * epsilon);
+    double Binomial::computeGreek(const Option& option, GreekType greekType) const {
+        return computeGreeks(option, greekBit(greekType)).get(greekType);
     }
 
-    double Binomial::calculateVega(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.01;
-        double pricePlus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility) + epsilon, option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility) - epsilon, option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        return (pricePlus - priceMinus) / (2 * epsilon);
+    Greeks Binomial::computeGreeks(const Option& option, GreekMask mask) const {
+        Greeks all = valuation(option, mask).greeks;
+        Greeks greeks;
+        for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+            if (mask & greekBit(type)) {
+                greeks.set(type, all.get(type));
+            }
+        }
+        return greeks;
     }
 
-    double Binomial::calculateTheta(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 1.0 / 365;
-        double priceNow = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        double priceLater = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry() - epsilon, static_cast<int>(std::pow(10, 4)));
-        return (priceLater - priceNow) / epsilon;
+    Valuation Binomial::priceWithGreeks(const Option& option, GreekMask mask) const {
+        return valuation(option, mask);
     }
 
-    double Binomial::calculateRho(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.0001;
-        double pricePlus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate) + epsilon, asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate) - epsilon, asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 4)));
-        return (pricePlus - priceMinus) / (2 * epsilon);
+    Valuation Binomial::valuation(const Option& option, GreekMask mask) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        const double S = market.spotPrice;
+        const double r = market.get(Param::riskFreeRate);
+        const double sigma = optionVolatility(option, market, surface);
+        const double K = option.getStrikePrice();
+        const double T = option.getTimeToExpiry();
+
+        // Price, Delta, Gamma and Theta come from one tree (or Richardson pair)
+        int numSteps = 0;
+        Valuation result = valuationWrapper(option, S, r, sigma, K, T, numSteps);
+
+        // Vega and Rho by central bumps, repriced concurrently on trees of the same size
+        const double dSigma = 0.01, dR = 0.0001;
+        struct Bump { GreekType greek; double vol, rate; };
+        std::vector<Bump> bumps;
+        if (mask & greekBit(GreekType::Vega)) {
+            bumps.push_back({GreekType::Vega, sigma + dSigma, r});
+            bumps.push_back({GreekType::Vega, sigma - dSigma, r});
+        }
+        if (mask & greekBit(GreekType::Rho)) {
+            bumps.push_back({GreekType::Rho, sigma, r + dR});
+            bumps.push_back({GreekType::Rho, sigma, r - dR});
+        }
+        std::vector<double> bumped(bumps.size());
+        context.parallelFor(0, bumps.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) {
+                int steps = numSteps;
+                bumped[k] = valuationWrapper(option, S, bumps[k].rate, bumps[k].vol, K, T, steps).price;
+            }
+        });
+        for (std::size_t k = 0; k < bumps.size(); k += 2) {
+            const double width = (bumps[k].greek == GreekType::Vega) ? 2 * dSigma : 2 * dR;
+            result.greeks.set(bumps[k].greek, (bumped[k] - bumped[k + 1]) / width);
+        }
+        return result;
     }
 
     double Binomial::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
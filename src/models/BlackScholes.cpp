@@ -3,10 +3,14 @@
 //
 
 #include <OptionLib/models/BlackScholes.h>
+#include <OptionLib/VolSurface.h>
+#include "simd/Kernels.h"
 #include <cmath>
 #include <stdexcept>
 #include <limits>
 #include <algorithm>
+#include <array>
+#include <vector>
 
 double approxErfInv(double x) {
     const double a = 0.147;  // Constant for the approximation
@@ -26,118 +30,247 @@ namespace OptionLib::Models {
         return std::exp(-0.5 * value * value) / std::sqrt(2 * M_PI);
     }
 
-    double BlackScholes::price(const Option& option) const {
+    BlackScholes::BlackScholes(ExecutionContext context)
+        : Model(std::move(context)) {}
 
-        auto asset = option.getAsset();
+    double BlackScholes::price(const Option& option) const {
+        requireVanilla(option, "BlackScholes");
+        requireEuropean(option, "BlackScholes");
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        double S = market.spotPrice;
         double K = option.getStrikePrice();
         double T = option.getTimeToExpiry();
+        double r = market.get(Param::riskFreeRate);
+        double sigma = optionVolatility(option, market, surface);
 
-        double d1 = (std::log(asset->getSpotPrice() / K) + (asset->get(Param::riskFreeRate) + 0.5 * asset->get(Param::volatility) * asset->get(Param::volatility)) * T) / (asset->get(Param::volatility) * std::sqrt(T));
-        double d2 = d1 - asset->get(Param::volatility) * std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * std::sqrt(T));
+        double d2 = d1 - sigma * std::sqrt(T);
 
         if (option.getType() == OptionType::Call) {
-            return asset->getSpotPrice() * normalCDF(d1) - K * std::exp(-asset->get(Param::riskFreeRate) * T) * normalCDF(d2);
+            return S * normalCDF(d1) - K * std::exp(-r * T) * normalCDF(d2);
         } else if (option.getType() == OptionType::Put) {
-            return K * std::exp(-asset->get(Param::riskFreeRate) * T) * normalCDF(-d2) - asset->getSpotPrice() * normalCDF(-d1);
+            return K * std::exp(-r * T) * normalCDF(-d2) - S * normalCDF(-d1);
         } else {
             throw std::invalid_argument("Unknown option type.");
         }
     }
 
-    double BlackScholes::computeGreek(const Option& option, GreekType greekType) const {
-        switch (greekType) {
-            case GreekType::Delta: return calculateDelta(option);
-            case GreekType::Gamma: return calculateGamma(option);
-            case GreekType::Vega: return calculateVega(option);
-            case GreekType::Theta: return calculateTheta(option);
-            case GreekType::Rho: return calculateRho(option);
-            default:
-                throw std::invalid_argument("Invalid Greek type");
+    void BlackScholes::priceBatch(const BatchInput& input, const BatchOutput& output) {
+        const std::size_t n = input.spot.size();
+        if (input.strike.size() != n || input.expiry.size() != n || input.volatility.size() != n ||
+            input.riskFreeRate.size() != n || input.type.size() != n) {
+            throw std::invalid_argument("Batch inputs must all have the same length.");
+        }
+
+        auto target = [n](std::span<double> out) -> double* {
+            if (out.empty()) {
+                return nullptr;
+            }
+            if (out.size() < n) {
+                throw std::invalid_argument("Batch output is shorter than the inputs.");
+            }
+            return out.data();
+        };
+
+        Simd::BlackScholesBatchArgs args{
+            input.spot.data(), input.strike.data(), input.expiry.data(),
+            input.volatility.data(), input.riskFreeRate.data(), input.type.data(),
+            target(output.price), target(output.delta), target(output.gamma),
+            target(output.vega), target(output.theta), target(output.rho),
+            n
+        };
+        if (n > 0) {
+            Simd::kernels().blackScholesBatch(args);
         }
     }
 
-    double BlackScholes::calculateDelta(const Option& option) {
-        auto asset = option.getAsset();
-        double K = option.getStrikePrice();
-        double T = option.getTimeToExpiry();
-        double d1 = (std::log(asset->getSpotPrice() / K) + (asset->get(Param::riskFreeRate) + 0.5 * asset->get(Param::volatility) * asset->get(Param::volatility)) * T) /
-                    (asset->get(Param::volatility) * std::sqrt(T));
-        if (option.getType() == OptionType::Call) {
-            return normalCDF(d1);
+    void BlackScholes::priceBatch(const OptionBatch& batch, std::span<double> prices) const {
+        for (const Option* option : batch.options) {
+            requireVanilla(*option, "BlackScholes");
+            requireEuropean(*option, "BlackScholes");
+        }
+
+        const std::size_t n = batch.options.size();
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = batch.asset->snapshot(surface);
+        const std::vector<double> spot(n, market.spotPrice);
+        const std::vector<double> rate(n, market.get(Param::riskFreeRate));
+        std::vector<double> volatility(n, 0.0);
+        if (surface) {
+            for (std::size_t i = 0; i < n; ++i) {
+                volatility[i] = surface->volatility(batch.strike[i], batch.expiry[i]);
+            }
         } else {
-            return normalCDF(d1) - 1;
+            std::fill(volatility.begin(), volatility.end(), market.get(Param::volatility));
         }
+        priceBatch({spot, batch.strike, batch.expiry, volatility, rate, batch.type}, {.price = prices});
     }
 
-    double BlackScholes::calculateGamma(const Option& option) {
-        auto asset = option.getAsset();
-        double K = option.getStrikePrice();
-        double T = option.getTimeToExpiry();
-        double d1 = (std::log(asset->getSpotPrice() / K) + (asset->get(Param::riskFreeRate) + 0.5 * asset->get(Param::volatility) * asset->get(Param::volatility)) * T) /
-                    (asset->get(Param::volatility) * std::sqrt(T));
-        return normalPDF(d1) / (asset->getSpotPrice() * asset->get(Param::volatility) * std::sqrt(T));
+    namespace {
+        // Contracts per task; a typical option chain fits in one
+        constexpr std::size_t ImpliedVolatilityBlock = 256;
+
+        ImpliedVolatilityStatus toStatus(double code) {
+            switch (static_cast<Simd::ImpliedVolatilityCode>(static_cast<int>(code))) {
+                case Simd::ImpliedVolatilityCode::Converged:
+                    return ImpliedVolatilityStatus::Converged;
+                case Simd::ImpliedVolatilityCode::BelowIntrinsic:
+                    return ImpliedVolatilityStatus::BelowIntrinsic;
+                case Simd::ImpliedVolatilityCode::AboveMaximum:
+                    return ImpliedVolatilityStatus::AboveMaximum;
+                default:
+                    return ImpliedVolatilityStatus::NotConverged;
+            }
+        }
     }
 
-    double BlackScholes::calculateVega(const Option& option) {
-        auto asset = option.getAsset();
-        double K = option.getStrikePrice();
-        double T = option.getTimeToExpiry();
-        double d1 = (std::log(asset->getSpotPrice() / K) + (asset->get(Param::riskFreeRate) + 0.5 * asset->get(Param::volatility) * asset->get(Param::volatility)) * T) /
-                    (asset->get(Param::volatility) * std::sqrt(T));
-        return asset->getSpotPrice() * normalPDF(d1) * std::sqrt(T);
+    void BlackScholes::impliedVolatilityBatch(const ImpliedVolatilityInput& input, const ImpliedVolatilityOutput& output) const {
+        const std::size_t n = input.price.size();
+        if (input.spot.size() != n || input.strike.size() != n || input.expiry.size() != n ||
+            input.riskFreeRate.size() != n || input.type.size() != n) {
+            throw std::invalid_argument("Batch inputs must all have the same length.");
+        }
+        if (output.volatility.size() < n || (!output.status.empty() && output.status.size() < n) ||
+            (!output.iterations.empty() && output.iterations.size() < n)) {
+            throw std::invalid_argument("Batch output is shorter than the inputs.");
+        }
+
+        const Simd::KernelTable& kernels = Simd::kernels();
+        const std::size_t numBlocks = (n + ImpliedVolatilityBlock - 1) / ImpliedVolatilityBlock;
+        context.parallelFor(0, numBlocks, 1, [&](std::size_t firstBlock, std::size_t lastBlock) {
+            std::array<double, ImpliedVolatilityBlock> phi, status, iterations;
+            for (std::size_t block = firstBlock; block < lastBlock; ++block) {
+                const std::size_t begin = block * ImpliedVolatilityBlock;
+                const std::size_t count = std::min(ImpliedVolatilityBlock, n - begin);
+                for (std::size_t i = 0; i < count; ++i) {
+                    phi[i] = input.type[begin + i] == OptionType::Call ? 1.0 : -1.0;
+                }
+
+                Simd::ImpliedVolatilityBatchArgs args{
+                    input.price.data() + begin, input.spot.data() + begin, input.strike.data() + begin,
+                    input.expiry.data() + begin, input.riskFreeRate.data() + begin, phi.data(),
+                    output.volatility.data() + begin,
+                    output.status.empty() ? nullptr : status.data(),
+                    output.iterations.empty() ? nullptr : iterations.data(),
+                    count
+                };
+                kernels.impliedVolatilityBatch(args);
+
+                for (std::size_t i = 0; i < count && !output.status.empty(); ++i) {
+                    output.status[begin + i] = toStatus(status[i]);
+                }
+                for (std::size_t i = 0; i < count && !output.iterations.empty(); ++i) {
+                    output.iterations[begin + i] = static_cast<unsigned>(iterations[i]);
+                }
+            }
+        });
     }
 
-    double BlackScholes::calculateTheta(const Option& option) {
-        auto asset = option.getAsset();
-        double K = option.getStrikePrice();
-        double T = option.getTimeToExpiry();
-        double d1 = (std::log(asset->getSpotPrice() / K) + (asset->get(Param::riskFreeRate) + 0.5 * asset->get(Param::volatility) * asset->get(Param::volatility)) * T) /
-                    (asset->get(Param::volatility) * std::sqrt(T));
-        double d2 = d1 - asset->get(Param::volatility) * std::sqrt(T);
-        if (option.getType() == OptionType::Call) {
-            return -asset->getSpotPrice() * normalPDF(d1) * asset->get(Param::volatility) / (2 * std::sqrt(T)) - asset->get(Param::riskFreeRate) * K * std::exp(-asset->get(Param::riskFreeRate) * T) * normalCDF(d2);
-        } else {
-            return -asset->getSpotPrice() * normalPDF(d1) * asset->get(Param::volatility) / (2 * std::sqrt(T)) + asset->get(Param::riskFreeRate) * K * std::exp(-asset->get(Param::riskFreeRate) * T) * normalCDF(-d2);
+    double BlackScholes::impliedVolatility(const Option& option, double marketPrice) const {
+        requireVanilla(option, "BlackScholes");
+        requireEuropean(option, "BlackScholes");
+        const MarketSnapshot market = option.getAsset()->snapshot();
+        const double spot = market.spotPrice;
+        const double strike = option.getStrikePrice();
+        const double expiry = option.getTimeToExpiry();
+        const double rate = market.get(Param::riskFreeRate);
+        const OptionType type = option.getType();
+
+        double volatility = 0.0;
+        ImpliedVolatilityStatus status = ImpliedVolatilityStatus::NotConverged;
+        impliedVolatilityBatch({{&marketPrice, 1}, {&spot, 1}, {&strike, 1}, {&expiry, 1}, {&rate, 1}, {&type, 1}},
+                               {{&volatility, 1}, {&status, 1}, {}});
+        switch (status) {
+            case ImpliedVolatilityStatus::Converged:
+                return volatility;
+            case ImpliedVolatilityStatus::BelowIntrinsic:
+                throw std::invalid_argument("Price is below the option's intrinsic value.");
+            case ImpliedVolatilityStatus::AboveMaximum:
+                throw std::invalid_argument("Price is above the option's maximum value.");
+            default:
+                throw std::invalid_argument("Implied volatility did not converge.");
         }
     }
 
-    double BlackScholes::calculateRho(const Option& option) {
-        auto asset = option.getAsset();
+    double BlackScholes::computeGreek(const Option& option, GreekType greekType) const {
+        return computeGreeks(option, greekBit(greekType)).get(greekType);
+    }
+
+    Greeks BlackScholes::computeGreeks(const Option& option, GreekMask mask) const {
+        requireVanilla(option, "BlackScholes");
+        requireEuropean(option, "BlackScholes");
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        double S = market.spotPrice;
         double K = option.getStrikePrice();
         double T = option.getTimeToExpiry();
-        double d2 = (std::log(asset->getSpotPrice() / K) + (asset->get(Param::riskFreeRate) - 0.5 * asset->get(Param::volatility) * asset->get(Param::volatility)) * T) /
-                    (asset->get(Param::volatility) * std::sqrt(T));
-        if (option.getType() == OptionType::Call) {
-            return K * T * std::exp(-asset->get(Param::riskFreeRate) * T) * normalCDF(d2);
-        } else {
-            return -K * T * std::exp(-asset->get(Param::riskFreeRate) * T) * normalCDF(-d2);
+        double r = market.get(Param::riskFreeRate);
+        double sigma = optionVolatility(option, market, surface);
+
+        // d1, d2 and the densities are shared by every Greek
+        double sqrtT = std::sqrt(T);
+        double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * sqrtT);
+        double d2 = d1 - sigma * sqrtT;
+        double pdf = normalPDF(d1);
+        double discountedK = K * std::exp(-r * T);
+        bool isCall = option.getType() == OptionType::Call;
+        double nd1 = normalCDF(d1);
+        double nd2 = isCall ? normalCDF(d2) : normalCDF(-d2);
+
+        Greeks greeks;
+        if (mask & greekBit(GreekType::Delta)) {
+            greeks.delta = isCall ? nd1 : nd1 - 1;
+        }
+        if (mask & greekBit(GreekType::Gamma)) {
+            greeks.gamma = pdf / (S * sigma * sqrtT);
         }
+        if (mask & greekBit(GreekType::Vega)) {
+            greeks.vega = S * pdf * sqrtT;
+        }
+        if (mask & greekBit(GreekType::Theta)) {
+            double decay = -S * pdf * sigma / (2 * sqrtT);
+            greeks.theta = isCall ? decay - r * discountedK * nd2 : decay + r * discountedK * nd2;
+        }
+        if (mask & greekBit(GreekType::Rho)) {
+            greeks.rho = isCall ? T * discountedK * nd2 : -T * discountedK * nd2;
+        }
+        return greeks;
     }
 
-    double BlackScholes::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
-        auto asset = option.getAsset();
-        double optionPrice = price(option);
-        double adjustedVolatility = asset->get(Param::volatility) * std::sqrt(holdingPeriod);
+    double BlackScholes::relativeCost() const {
+        return 1.0;
+    }
+
+    double BlackScholes::lognormalVaR(double price, double volatility, double confidenceLevel, double holdingPeriod) {
+        double adjustedVolatility = volatility * std::sqrt(holdingPeriod);
 
         // Calculate the Z-score for the specified confidence level
         double zScore = approxErfInv(2 * confidenceLevel - 1) * std::sqrt(2);  // Using Boost's erf_inv
 
         // Calculate VaR as the expected loss at the confidence level
-        return optionPrice * (1 - std::exp(-zScore * adjustedVolatility));
+        return price * (1 - std::exp(-zScore * adjustedVolatility));
     }
 
-    double BlackScholes::ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const {
-        double VaR = this->VaR(option, confidenceLevel, holdingPeriod);
-
-        auto asset = option.getAsset();
+    double BlackScholes::lognormalExpectedShortfall(double price, double volatility, double confidenceLevel,
+                                                    double holdingPeriod) {
         // Mean Excess Loss beyond VaR
-        double optionPrice = price(option);
-        double adjustedVolatility = asset->get(Param::volatility) * std::sqrt(holdingPeriod);
+        double adjustedVolatility = volatility * std::sqrt(holdingPeriod);
+        double meanExcessLoss = price * adjustedVolatility * approxErfInv(2 * confidenceLevel - 1) / std::sqrt(M_PI);
+        return lognormalVaR(price, volatility, confidenceLevel, holdingPeriod) + meanExcessLoss;
+    }
 
-        // Expected Shortfall calculation (adjusted for Black-Scholes assumptions)
-        double meanExcessLoss = optionPrice * adjustedVolatility * approxErfInv(2 * confidenceLevel - 1) / std::sqrt(M_PI);
-        return VaR + meanExcessLoss;
+    double BlackScholes::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        return lognormalVaR(price(option), optionVolatility(option, market, surface), confidenceLevel, holdingPeriod);
     }
 
+    double BlackScholes::ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        return lognormalExpectedShortfall(price(option), optionVolatility(option, market, surface), confidenceLevel,
+                                          holdingPeriod);
+    }
 
 } // namespace OptionLib::Models
\ No newline at end of file
@@ -0,0 +1,294 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/models/FiniteDifference.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace OptionLib::Models {
+
+    FiniteDifference::FiniteDifference(ExecutionContext context)
+        : Model(std::move(context)) {}
+
+    FiniteDifference::FiniteDifference(Settings settings, ExecutionContext context)
+        : Model(std::move(context)), settings(settings) {}
+
+    namespace {
+
+        // Penalty weight forcing V >= payoff at nodes below it, and the most active-set
+        // iterations per time step
+        constexpr double Penalty = 1e8;
+        constexpr int MaxPenaltyIterations = 50;
+
+        // Central-difference weights on a non-uniform grid for the node between spacings hm and hp
+        struct Stencil {
+            double lower, centre, upper;
+        };
+
+        Stencil firstDerivative(double hm, double hp) {
+            return {-hp / (hm * (hm + hp)), (hp - hm) / (hm * hp), hm / (hp * (hm + hp))};
+        }
+
+        Stencil secondDerivative(double hm, double hp) {
+            return {2.0 / (hm * (hm + hp)), -2.0 / (hm * hp), 2.0 / (hp * (hm + hp))};
+        }
+
+        // Solves the tridiagonal system (lower, diag, upper) x = rhs in place of rhs; scratch
+        // holds the modified upper diagonal
+        void solveTridiagonal(const std::vector<double>& lower, const std::vector<double>& diag,
+                              const std::vector<double>& upper, std::vector<double>& rhs, std::vector<double>& scratch) {
+            const std::size_t n = diag.size();
+            scratch[0] = upper[0] / diag[0];
+            rhs[0] /= diag[0];
+            for (std::size_t i = 1; i < n; ++i) {
+                const double denominator = diag[i] - lower[i] * scratch[i - 1];
+                scratch[i] = upper[i] / denominator;
+                rhs[i] = (rhs[i] - lower[i] * rhs[i - 1]) / denominator;
+            }
+            for (std::size_t i = n - 1; i-- > 0;) {
+                rhs[i] -= scratch[i] * rhs[i + 1];
+            }
+        }
+
+        double interpolate(const std::vector<double>& x, const std::vector<double>& y, std::size_t i, double at) {
+            const double x0 = x[i - 1], x1 = x[i], x2 = x[i + 1];
+            return y[i - 1] * (at - x1) * (at - x2) / ((x0 - x1) * (x0 - x2))
+                 + y[i] * (at - x0) * (at - x2) / ((x1 - x0) * (x1 - x2))
+                 + y[i + 1] * (at - x0) * (at - x1) / ((x2 - x0) * (x2 - x1));
+        }
+
+    } // namespace
+
+    Valuation FiniteDifference::Grid::at(double spot) const {
+        if (spot < spots.front() || spot > spots.back()) {
+            throw std::out_of_range("FiniteDifference::Grid::at: spot outside the grid");
+        }
+        const std::size_t above = std::upper_bound(spots.begin(), spots.end(), spot) - spots.begin();
+        const std::size_t centre = std::clamp<std::size_t>(above, 1, spots.size() - 2);
+        Valuation valuation;
+        valuation.price = interpolate(spots, prices, centre, spot);
+        valuation.greeks.delta = interpolate(spots, deltas, centre, spot);
+        valuation.greeks.gamma = interpolate(spots, gammas, centre, spot);
+        valuation.greeks.theta = interpolate(spots, thetas, centre, spot);
+        return valuation;
+    }
+
+    FiniteDifference::Grid FiniteDifference::solveWrapper(const Option& option, double spotPrice, double riskFreeRate,
+                                                          double volatility, double gridVolatility) const {
+        requireVanilla(option, "FiniteDifference");
+        const double K = option.getStrikePrice();
+        const double T = option.getTimeToExpiry();
+        const double r = riskFreeRate;
+        const double sign = (option.getType() == OptionType::Call) ? 1.0 : -1.0;
+        const std::size_t n = std::max<std::size_t>(settings.spotNodes, 5);
+        const std::size_t numSteps = std::max<std::size_t>(settings.timeSteps, 1);
+        const double dt = T / static_cast<double>(numSteps);
+
+        // Sinh grid S = K + c sinh(x) over [0, Smax], x uniform: spacing ~c at the strike,
+        // growing proportionally to |S - K| away from it
+        Grid grid;
+        std::vector<double>& S = grid.spots;
+        S.resize(n);
+        const double maxSpot = std::max(spotPrice, K) * std::max(std::exp(settings.gridWidth * gridVolatility * std::sqrt(T)), 2.0);
+        const double c = settings.concentration * K;
+        const double xMin = std::asinh(-K / c), xMax = std::asinh((maxSpot - K) / c);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = K + c * std::sinh(xMin + (xMax - xMin) * static_cast<double>(i) / static_cast<double>(n - 1));
+        }
+        S[0] = 0.0;
+
+        // Spatial operator L V = a V[i-1] + b V[i] + c V[i+1]; at S = 0 it reduces to -r V, and
+        // the top node is held at its asymptotic value
+        std::vector<double> a(n, 0.0), b(n, 0.0), up(n, 0.0), payoff(n);
+        b[0] = -r;
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            const Stencil first = firstDerivative(S[i] - S[i - 1], S[i + 1] - S[i]);
+            const Stencil second = secondDerivative(S[i] - S[i - 1], S[i + 1] - S[i]);
+            const double diffusion = 0.5 * volatility * volatility * S[i] * S[i], drift = r * S[i];
+            a[i] = diffusion * second.lower + drift * first.lower;
+            b[i] = diffusion * second.centre + drift * first.centre - r;
+            up[i] = diffusion * second.upper + drift * first.upper;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            payoff[i] = std::max(sign * (S[i] - K), 0.0);
+        }
+        auto topValue = [&](double tau) { return (sign > 0.0) ? S[n - 1] - K * std::exp(-r * tau) : 0.0; };
+
+        // Time steps (in time to expiry) after which Bermudan holders may exercise
+        const bool american = option.getExerciseStyle() == ExerciseStyle::American;
+        std::vector<char> exercisable(numSteps + 1, 0);
+        if (option.getExerciseStyle() == ExerciseStyle::Bermudan) {
+            for (double date : option.getExerciseDates()) {
+                exercisable[static_cast<std::size_t>(std::lround((T - date) / dt))] = 1;
+            }
+        }
+
+        std::vector<double> V = payoff, rhs(n), lower(n), diag(n), upper(n), scratch(n), system(n), solution(n);
+        std::vector<char> exercised(n, 0);
+        double tau = 0.0;
+        for (std::size_t step = 1; step <= numSteps; ++step) {
+            // Rannacher start-up: two implicit half-steps in place of each early Crank-Nicolson step
+            const bool startUp = step <= settings.rannacherSteps;
+            const double theta = startUp ? 1.0 : 0.5;
+            const double h = startUp ? 0.5 * dt : dt;
+            for (int substep = 0; substep < (startUp ? 2 : 1); ++substep) {
+                tau += h;
+                for (std::size_t i = 0; i + 1 < n; ++i) {
+                    const double explicitPart = a[i] * (i > 0 ? V[i - 1] : 0.0) + b[i] * V[i] + up[i] * V[i + 1];
+                    rhs[i] = V[i] + (1.0 - theta) * h * explicitPart;
+                    lower[i] = -theta * h * a[i];
+                    diag[i] = 1.0 - theta * h * b[i];
+                    upper[i] = -theta * h * up[i];
+                }
+                lower[n - 1] = 0.0;
+                diag[n - 1] = 1.0;
+                upper[n - 1] = 0.0;
+                rhs[n - 1] = topValue(tau);
+
+                if (!american) {
+                    solveTridiagonal(lower, diag, upper, rhs, scratch);
+                    V.swap(rhs);
+                    continue;
+                }
+                // Penalty iteration: nodes below the payoff are pulled onto it, re-solving until
+                // the set of such nodes stops changing
+                for (std::size_t i = 0; i < n; ++i) {
+                    exercised[i] = V[i] < payoff[i];
+                }
+                for (int iteration = 0; iteration < MaxPenaltyIterations; ++iteration) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const double penalty = exercised[i] ? Penalty : 0.0;
+                        system[i] = diag[i] + penalty;
+                        solution[i] = rhs[i] + penalty * payoff[i];
+                    }
+                    solveTridiagonal(lower, system, upper, solution, scratch);
+                    bool changed = false;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const char below = solution[i] < payoff[i];
+                        changed |= below != exercised[i];
+                        exercised[i] = below;
+                    }
+                    if (!changed) {
+                        break;
+                    }
+                }
+                V.swap(solution);
+            }
+            if (exercisable[step]) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    exercised[i] = V[i] <= payoff[i];
+                    V[i] = std::max(V[i], payoff[i]);
+                }
+            }
+        }
+        if (!american && !exercisable[numSteps]) {
+            std::fill(exercised.begin(), exercised.end(), 0);
+        }
+
+        // Spot Greeks from the same stencils; Theta = -dV/dT from the PDE, zero where exercised
+        grid.prices = V;
+        grid.deltas.assign(n, 0.0);
+        grid.gammas.assign(n, 0.0);
+        grid.thetas.assign(n, 0.0);
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            const Stencil first = firstDerivative(S[i] - S[i - 1], S[i + 1] - S[i]);
+            const Stencil second = secondDerivative(S[i] - S[i - 1], S[i + 1] - S[i]);
+            grid.deltas[i] = first.lower * V[i - 1] + first.centre * V[i] + first.upper * V[i + 1];
+            grid.gammas[i] = second.lower * V[i - 1] + second.centre * V[i] + second.upper * V[i + 1];
+            if (!exercised[i]) {
+                grid.thetas[i] = -(0.5 * volatility * volatility * S[i] * S[i] * grid.gammas[i]
+                                   + r * S[i] * grid.deltas[i] - r * V[i]);
+            }
+        }
+        grid.deltas[0] = grid.deltas[1];
+        grid.deltas[n - 1] = grid.deltas[n - 2];
+        grid.gammas[0] = grid.gammas[1];
+        grid.gammas[n - 1] = grid.gammas[n - 2];
+        grid.thetas[0] = grid.thetas[1];
+        grid.thetas[n - 1] = grid.thetas[n - 2];
+        return grid;
+    }
+
+    FiniteDifference::Grid FiniteDifference::solve(const Option& option) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        const double sigma = optionVolatility(option, market, surface);
+        return solveWrapper(option, market.spotPrice, market.get(Param::riskFreeRate), sigma, sigma);
+    }
+
+    double FiniteDifference::price(const Option& option) const {
+        return solve(option).at(option.getAsset()->snapshot().spotPrice).price;
+    }
+
+    double FiniteDifference::computeGreek(const Option& option, GreekType greekType) const {
+        return computeGreeks(option, greekBit(greekType)).get(greekType);
+    }
+
+    Greeks FiniteDifference::computeGreeks(const Option& option, GreekMask mask) const {
+        Greeks all = valuation(option, mask).greeks;
+        Greeks greeks;
+        for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+            if (mask & greekBit(type)) {
+                greeks.set(type, all.get(type));
+            }
+        }
+        return greeks;
+    }
+
+    Valuation FiniteDifference::priceWithGreeks(const Option& option, GreekMask mask) const {
+        return valuation(option, mask);
+    }
+
+    Valuation FiniteDifference::valuation(const Option& option, GreekMask mask) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        const double S = market.spotPrice;
+        const double r = market.get(Param::riskFreeRate);
+        const double sigma = optionVolatility(option, market, surface);
+        Valuation result = solveWrapper(option, S, r, sigma, sigma).at(S);
+
+        // Vega and Rho by central bumps on the same grid, solved concurrently
+        const double dSigma = 0.01, dR = 0.0001;
+        struct Bump { GreekType greek; double vol, rate; };
+        std::vector<Bump> bumps;
+        if (mask & greekBit(GreekType::Vega)) {
+            bumps.push_back({GreekType::Vega, sigma + dSigma, r});
+            bumps.push_back({GreekType::Vega, sigma - dSigma, r});
+        }
+        if (mask & greekBit(GreekType::Rho)) {
+            bumps.push_back({GreekType::Rho, sigma, r + dR});
+            bumps.push_back({GreekType::Rho, sigma, r - dR});
+        }
+        std::vector<double> bumped(bumps.size());
+        context.parallelFor(0, bumps.size(), 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) {
+                bumped[k] = solveWrapper(option, S, bumps[k].rate, bumps[k].vol, sigma).at(S).price;
+            }
+        });
+        for (std::size_t k = 0; k < bumps.size(); k += 2) {
+            const double width = (bumps[k].greek == GreekType::Vega) ? 2 * dSigma : 2 * dR;
+            result.greeks.set(bumps[k].greek, (bumped[k] - bumped[k + 1]) / width);
+        }
+        return result;
+    }
+
+    const FiniteDifference::Settings& FiniteDifference::getSettings() const {
+        return settings;
+    }
+
+    void FiniteDifference::setSettings(const Settings& newSettings) {
+        settings = newSettings;
+    }
+
+    double FiniteDifference::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        throw std::logic_error("FiniteDifference::VaR is not yet implemented.");
+    }
+
+    double FiniteDifference::ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        throw std::logic_error("FiniteDifference::ExpectedShortfall is not yet implemented.");
+    }
+
+} // namespace OptionLib::Models
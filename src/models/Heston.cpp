@@ -3,120 +3,628 @@
 //
 
 #include "OptionLib/models/Heston.h"
+#include "HestonFourier.h"
 #include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <algorithm>
+#include <array>
 #include <complex>
 #include <stdexcept>
 #include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace OptionLib::Models {
 
     using namespace std;
     using namespace std::complex_literals;
 
-    // Convenience function for necessary Heston parameters
-    auto getHestonParameters(const Asset& asset, const Option& option) {
+    // Convenience function for necessary Heston parameters, read once from a market snapshot
+    auto getHestonParameters(const MarketSnapshot& market, double expiry, double strike) {
         return std::make_tuple(
-            asset.get(Param::meanReversion),                                // kappa
-            asset.get(Param::longTermVariance),                             // theta
-            asset.get(Param::volOfVol),                                     // zeta
-            asset.get(Param::hestonCorrelation),                            // rho
-            asset.get(Param::volatility) * asset.get(Param::volatility),    // v0
-            asset.get(Param::riskFreeRate),                                 // r
-            option.getTimeToExpiry(),                                       // T
-            option.getStrikePrice(),                                        // K
-            asset.getSpotPrice()                                            // S
+            market.get(Param::meanReversion),                                 // kappa
+            market.get(Param::longTermVariance),                              // theta
+            market.get(Param::volOfVol),                                      // zeta
+            market.get(Param::hestonCorrelation),                             // rho
+            market.get(Param::volatility) * market.get(Param::volatility),    // v0
+            market.get(Param::riskFreeRate),                                  // r
+            expiry,                                                           // T
+            strike,                                                           // K
+            market.spotPrice                                                  // S
         );
     }
 
+    auto getHestonParameters(const MarketSnapshot& market, const Option& option) {
+        return getHestonParameters(market, option.getTimeToExpiry(), option.getStrikePrice());
+    }
+
+    using HestonParameters = decltype(getHestonParameters(std::declval<const MarketSnapshot&>(), std::declval<const Option&>()));
+
+    namespace {
+
+        // Complex number carrying its gradient in (volatility, meanReversion, longTermVariance,
+        // volOfVol, hestonCorrelation), for forward-mode differentiation of phi
+        struct DualComplex {
+            complex<double> value;
+            std::array<complex<double>, NumCalibratedParameters> gradient{};
+        };
+
+        DualComplex variable(double value, std::size_t index) {
+            DualComplex x{value, {}};
+            x.gradient[index] = 1.0;
+            return x;
+        }
+
+        // Applies a function with value f and derivative df at x.value
+        DualComplex chain(const DualComplex& x, complex<double> f, complex<double> df) {
+            DualComplex y{f, {}};
+            for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                y.gradient[j] = df * x.gradient[j];
+            }
+            return y;
+        }
+
+        DualComplex operator+(const DualComplex& x, const DualComplex& y) {
+            DualComplex z{x.value + y.value, {}};
+            for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                z.gradient[j] = x.gradient[j] + y.gradient[j];
+            }
+            return z;
+        }
+
+        DualComplex operator-(const DualComplex& x, const DualComplex& y) {
+            DualComplex z{x.value - y.value, {}};
+            for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                z.gradient[j] = x.gradient[j] - y.gradient[j];
+            }
+            return z;
+        }
+
+        DualComplex operator*(const DualComplex& x, const DualComplex& y) {
+            DualComplex z{x.value * y.value, {}};
+            for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                z.gradient[j] = x.gradient[j] * y.value + x.value * y.gradient[j];
+            }
+            return z;
+        }
+
+        DualComplex operator/(const DualComplex& x, const DualComplex& y) {
+            const complex<double> inverse = 1.0 / y.value;
+            DualComplex z{x.value * inverse, {}};
+            for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                z.gradient[j] = (x.gradient[j] - z.value * y.gradient[j]) * inverse;
+            }
+            return z;
+        }
+
+        // exp, log and sqrt for both number types of characteristicParts
+        complex<double> expOf(const complex<double>& x) { return exp(x); }
+        complex<double> logOf(const complex<double>& x) { return log(x); }
+        complex<double> sqrtOf(const complex<double>& x) { return sqrt(x); }
+
+        DualComplex expOf(const DualComplex& x) {
+            const complex<double> e = exp(x.value);
+            return chain(x, e, e);
+        }
+
+        DualComplex logOf(const DualComplex& x) {
+            return chain(x, log(x.value), 1.0 / x.value);
+        }
+
+        DualComplex sqrtOf(const DualComplex& x) {
+            const complex<double> root = sqrt(x.value);
+            return chain(x, root, 0.5 / root);
+        }
+
+        // Intermediate terms of phi(u) = exp(iu m + alpha + beta v0), with m = ln S + rT
+        template <typename Number>
+        struct CharacteristicParts {
+            Number g, D, C, E, alpha, beta, phi;
+        };
+
+        // The one implementation of the Heston characteristic function, in the form that stays
+        // continuous in u: g = kappa - rho zeta iu, D = sqrt(g^2 + zeta^2 (iu + u^2)),
+        // C = (g - D) / (g + D) and E = e^{-DT}. Number is complex<double>, or DualComplex to
+        // carry the gradient in the calibrated parameters.
+        template <typename Number>
+        CharacteristicParts<Number> characteristicParts(const Number& iu, const Number& uSquared, const Number& kappa,
+                                                        const Number& theta, const Number& zeta, const Number& rho,
+                                                        const Number& v0, const Number& T, const Number& m) {
+            const Number zero{0.0}, one{1.0}, two{2.0};
+            CharacteristicParts<Number> parts;
+            parts.g = kappa - rho * zeta * iu;
+            parts.D = sqrtOf(parts.g * parts.g + zeta * zeta * (iu + uSquared));
+            parts.C = (parts.g - parts.D) / (parts.g + parts.D);
+            parts.E = expOf(zero - parts.D * T);
+            parts.beta = (parts.g - parts.D) * (one - parts.E) / (zeta * zeta * (one - parts.C * parts.E));
+            parts.alpha = kappa * theta / (zeta * zeta)
+                        * ((parts.g - parts.D) * T - two * logOf((one - parts.C * parts.E) / (one - parts.C)));
+            parts.phi = expOf(iu * m + parts.alpha + parts.beta * v0);
+            return parts;
+        }
+
+        CharacteristicParts<complex<double>> characteristicParts(const complex<double>& u, const HestonParameters& parameters) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            using Number = complex<double>;
+            return characteristicParts<Number>(Number(0.0, 1.0) * u, u * u, kappa, theta, zeta, rho, v0, T, log(S) + r * T);
+        }
+
+    } // namespace
+
+    complex<double> characteristicFunction(const complex<double>& u, const HestonParameters& parameters) {
+        return characteristicParts(u, parameters).phi;
+    }
+
     std::complex<double> Heston::characteristicFunction(const std::complex<double>& u, const Option& option, const Asset& asset) {
-        using namespace std::complex_literals;
-        auto [kappa, theta, zeta, rho, v0, r, T, K, S] = getHestonParameters(asset, option);
-        double m = log(S) + r * T;
-        complex<double> D = sqrt(pow(rho * zeta * 1i * u - kappa, 2) + pow(zeta, 2) * (1i * u + pow(u, 2)));
-        complex<double> C = (kappa - rho*zeta*1i*u - D)/(kappa-rho*zeta*1i*u + D);
-        complex<double> beta = ((kappa - rho*zeta*1i*u - D)*(1.0-exp(-D*T))) / (pow(zeta,2)*(1.0-C*exp(-D*T)));
-        complex<double> alpha = ((kappa*theta)/(pow(zeta,2))) * ((kappa-rho*zeta*1i*u-D)*T - 2.0*log((1.0-C*exp(-D*T))/(1.0-C)));
-        return exp(1i*u*m + alpha + beta*v0);
+        return Models::characteristicFunction(u, getHestonParameters(asset.snapshot(), option));
     }
 
-    // Fourier implementation of Heston price
-    double Heston::price(const Option& option) const {
-        double z = 24;
-        double N = 1021;
-        auto [kappa, theta, zeta, rho, v0, r, T, K, S] = getHestonParameters(*option.getAsset(), option);
-        double c1 = log(S) + r * T - 0.5 * theta * T;
-        double c2 = theta / (8 * pow(kappa, 3)) *
-                    (-pow(zeta, 2) * exp(-2 * kappa * T)
-                     + 4 * zeta * exp(-kappa * T) * (zeta - 2 * kappa * rho)
-                     + 2 * kappa * T * (4 * pow(kappa, 2) + pow(zeta, 2) - 4 * kappa * zeta * rho)
-                     + zeta * (8 * kappa * rho - 3 * zeta));
-
-        double a = c1 - z * sqrt(abs(c2));
-        double b = c1 + z * sqrt(abs(c2));
-        auto h = [&](int n) { return (n * M_PI) / (b - a); };
-        auto g_n = [&](int n) {
-            double h_n = h(n);
-            return (exp(a) - (K / h_n) * sin(h_n * (a - log(K))) - K * cos(h_n * (a - log(K)))) / (1 + pow(h_n, 2));
+    namespace {
+
+        constexpr double TruncationWidth = 24;  // half-width of [a, b] in standard deviations of ln S_T
+        constexpr int NumTerms = 1021;
+        constexpr double MaxTruncationWidth = 96;   // widest adaptive half-width, in the same units
+        constexpr int MaxAdaptiveTerms = 16384;
+
+        // phi(u) with its derivatives in v0 and T
+        struct CharacteristicTerms {
+            complex<double> phi, dPhiDVariance, dPhiDExpiry;
         };
-        double g0 = K * (log(K) - a - 1) + exp(a);
 
-        complex F = g0;
-        for (int n = 1; n <= N; ++n) {
-            double h_n = h(n);
-            F += 2.0 * characteristicFunction(h_n, option, *option.getAsset()) * exp(complex<double>(0, -1) * a * h_n) * g_n(n);
+        CharacteristicTerms characteristicTerms(double u, const HestonParameters& parameters) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            const auto [g, D, C, E, alpha, beta, phi] = characteristicParts(u, parameters);
+            const complex<double> iu(0.0, u);
+            const complex<double> dBetaDT = (g - D) / (zeta * zeta) * D * E * (1.0 - C) / ((1.0 - C * E) * (1.0 - C * E));
+            const complex<double> dAlphaDT = kappa * theta / (zeta * zeta) * ((g - D) - 2.0 * C * D * E / (1.0 - C * E));
+            return {phi, beta * phi, (iu * r + dAlphaDT + dBetaDT * v0) * phi};
         }
-        double F_real = exp(-r * T) / (b - a) * real(F);
 
-        if (option.getType() == OptionType::Call) {
-            // Put-call parity
-            F_real += S - K * exp(-r * T);
+        // phi(u) with its gradient in the calibrated parameters, with v0 = volatility^2
+        DualComplex characteristicFunctionGradient(double u, const HestonParameters& parameters) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            const DualComplex sigma = variable(std::sqrt(v0), 0);
+            return characteristicParts<DualComplex>({{0.0, u}}, {u * u}, variable(kappa, 1), variable(theta, 2),
+                                                    variable(zeta, 3), variable(rho, 4), sigma * sigma, {T},
+                                                    {std::log(S) + r * T}).phi;
+        }
+
+        // Series of the COS expansion: the price and, with Greeks, its derivatives in S, S twice,
+        // v0, T and r, or with a parameter gradient, its derivatives in the calibrated parameters
+        // (term 1 + j for parameter j). The discounting and the put-call parity terms are applied
+        // afterwards.
+        enum class SeriesKind { Price, Greeks, ParameterGradient };
+        enum SeriesTerm { Value, DSpot, DSpotSpot, DVariance, DExpiry, DRate, TermCount };
+        static_assert(1 + NumCalibratedParameters == TermCount);
+        using TermSums = std::array<double, TermCount>;
+
+        // Strike-independent part of the COS expansion of a put: the truncation range [a, b] of
+        // ln S_T, from its first two cumulants, and Re(2 X(h_n) e^{-i a h_n}) for n = 1..count
+        // with X = phi or one of its derivatives
+        struct CosSeries {
+            double a, b;
+            std::size_t numTerms;               // 1 for the price alone, TermCount with Greeks
+            int count;                          // cosine terms kept
+            std::vector<double> weights;        // weights[(n - 1) * numTerms + term]
+        };
+
+        // ln E[S_T^q] for real q, from the real solution of the Heston Riccati equations; infinite
+        // once the moment has exploded before T
+        double logMoment(double q, const HestonParameters& parameters) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            const double beta = kappa - rho * zeta * q;
+            const double discriminant = beta * beta - zeta * zeta * (q * q - q);
+            const double zeta2 = zeta * zeta;
+            double A, B;
+            if (discriminant > 0.0) {
+                const double gamma = sqrt(discriminant);
+                if (beta + gamma <= 0.0 && log((beta - gamma) / (beta + gamma)) <= gamma * T) {
+                    return std::numeric_limits<double>::infinity();
+                }
+                const double g = (beta - gamma) / (beta + gamma);
+                const double e = exp(-gamma * T);
+                B = (beta - gamma) * (1.0 - e) / (zeta2 * (1.0 - g * e));
+                A = kappa * theta / zeta2 * ((beta - gamma) * T - 2.0 * log((1.0 - g * e) / (1.0 - g)));
+            } else {
+                const double gamma = sqrt(-discriminant);
+                const double phase = -atan(beta / gamma);
+                const double angle = 0.5 * gamma * T + phase;
+                if (angle >= 0.5 * M_PI) {
+                    return std::numeric_limits<double>::infinity();
+                }
+                B = (beta + gamma * tan(angle)) / zeta2;
+                A = kappa * theta / zeta2 * (beta * T - 2.0 * log(cos(angle) / cos(phase)));
+            }
+            return q * (log(S) + r * T) + A + B * v0;
+        }
+
+        // Truncation range for a price tolerance. A put loses at most K P(X < a) + K P(X > b) to
+        // the truncation, so each tail is held below tolerance / 4 by the Chernoff bounds
+        // P(X < a) <= E[e^{-pX}] e^{pa} and P(X > b) <= E[e^{pX}] e^{-pb}, taking the best of a few
+        // moment orders p. A tail with no finite moment keeps the fixed 24-sigma edge, and no edge
+        // goes beyond MaxTruncationWidth standard deviations.
+        std::pair<double, double> truncationRange(const HestonParameters& parameters, double tolerance, double maxStrike,
+                                                  double c1, double c2) {
+            const double sigma = sqrt(abs(c2));
+            const double logBudget = log(tolerance / (4.0 * std::max(maxStrike, 1.0)));
+            const double inf = std::numeric_limits<double>::infinity();
+            double a = -inf, b = inf;
+            for (double p : {0.0625, 0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0}) {
+                for (double sign : {-1.0, 1.0}) {
+                    const double q = sign * p;
+                    const double edge = (logMoment(q, parameters) - logBudget) / q;    // P beyond edge <= budget
+                    if (std::isnan(edge)) {
+                        continue;
+                    }
+                    if (sign < 0.0) {
+                        a = std::max(a, edge);
+                    } else {
+                        b = std::min(b, edge);
+                    }
+                }
+            }
+            a = (a == -inf) ? c1 - TruncationWidth * sigma : std::max(a, c1 - MaxTruncationWidth * sigma);
+            b = (b == inf) ? c1 + TruncationWidth * sigma : std::min(b, c1 + MaxTruncationWidth * sigma);
+            return {std::min(a, c1), std::max(b, c1)};
+        }
+
+        // Cumulants c1 = E[ln S_T] and c2 = Var[ln S_T] of the Heston log-spot
+        std::pair<double, double> logSpotCumulants(const HestonParameters& parameters) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            double c1 = log(S) + r * T - 0.5 * theta * T;
+            double c2 = theta / (8 * pow(kappa, 3)) *
+                        (-pow(zeta, 2) * exp(-2 * kappa * T)
+                         + 4 * zeta * exp(-kappa * T) * (zeta - 2 * kappa * rho)
+                         + 2 * kappa * T * (4 * pow(kappa, 2) + pow(zeta, 2) - 4 * kappa * zeta * rho)
+                         + zeta * (8 * kappa * rho - 3 * zeta));
+            return {c1, c2};
         }
-        return max(0.0, F_real);
+
+        // The fixed 24-sigma range
+        std::pair<double, double> fixedRange(const HestonParameters& parameters) {
+            const auto [c1, c2] = logSpotCumulants(parameters);
+            return {c1 - TruncationWidth * sqrt(abs(c2)), c1 + TruncationWidth * sqrt(abs(c2))};
+        }
+
+        // Bounds P_t(u) on |X_t(u)| / |phi(u)| for each series, polynomials in u with non-negative
+        // coefficients. They follow from |beta(tau)| <= tau |u^2 + iu| / 2: the Riccati equation
+        // beta' = zeta^2 beta^2 / 2 - (kappa - rho zeta iu) beta - (u^2 + iu) / 2 with Re beta <= 0
+        // (|phi| <= 1 for every v0) gives |beta|' <= |u^2 + iu| / 2, and the parameter derivatives
+        // of beta solve linear equations whose coefficient has real part at most -kappa, so each
+        // grows no faster than the integral of its forcing term. alpha is kappa theta times the
+        // integral of beta.
+        std::array<double, TermCount> seriesFactors(double u, SeriesKind kind, const HestonParameters& parameters) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            const double q = u * u + u;         // >= |u^2 + iu|
+            const double betaBound = 0.5 * T * q;
+            const double betaIntegral = 0.25 * T * T * q;
+            std::array<double, TermCount> factors{};
+            factors[Value] = 1.0;
+            if (kind == SeriesKind::Greeks) {
+                factors[DSpot] = u / S;
+                factors[DSpotSpot] = q / (S * S);
+                factors[DVariance] = betaBound;
+                const double dBetaDT = 0.5 * q + (kappa + abs(rho) * zeta * u) * betaBound
+                                     + 0.5 * zeta * zeta * betaBound * betaBound;
+                factors[DExpiry] = u * abs(r) + kappa * theta * betaBound + v0 * dBetaDT;
+                factors[DRate] = u * T;
+            } else if (kind == SeriesKind::ParameterGradient) {
+                // Bounds on the integrals over [0, T] of the derivatives of beta in kappa, zeta and rho
+                const double kappaIntegral = T * T * T * q / 12.0;
+                const double zetaIntegral = zeta * q * q * pow(T, 4) / 48.0 + abs(rho) * u * T * T * T * q / 12.0;
+                const double rhoIntegral = zeta * u * T * T * T * q / 12.0;
+                factors[1] = 2.0 * sqrt(v0) * betaBound;
+                factors[2] = theta * betaIntegral + kappa * theta * kappaIntegral + v0 * betaIntegral;
+                factors[3] = kappa * betaIntegral;
+                factors[4] = kappa * theta * zetaIntegral
+                           + v0 * (zeta * q * q * T * T * T / 12.0 + abs(rho) * u * q * T * T / 4.0);
+                factors[5] = kappa * theta * rhoIntegral + v0 * zeta * u * q * T * T / 4.0;
+            }
+            return factors;
+        }
+
+        // Degrees in u of the seriesFactors
+        std::array<int, TermCount> seriesDegrees(SeriesKind kind) {
+            if (kind == SeriesKind::Greeks) {
+                return {0, 1, 2, 2, 4, 1};
+            }
+            return {0, 2, 2, 2, 4, 3};
+        }
+
+        // Fewest terms for which every series of the expansion is within tolerance / 2 of its full
+        // sum, for every strike up to maxStrike; MaxAdaptiveTerms when no count is (|rho| = 1).
+        //
+        // Given the variance path, ln S_T is normal with variance (1 - rho^2) I, I the integrated
+        // variance, so |phi(u)| <= E[e^{-lambda I}] with lambda = (1 - rho^2) u^2 / 2. That is the
+        // CIR transform e^{-A - B v0}, and with gamma = sqrt(kappa^2 + zeta^2 (1 - rho^2) u^2),
+        // A >= 2 kappa theta / zeta^2 ((gamma - kappa) T / 2 - ln 2) and
+        // B >= (gamma - kappa) tanh(gamma T / 2) / zeta^2. Since gamma >= zeta sqrt(1 - rho^2) u,
+        // |phi(u)| <= e^{w kappa + 2 kappa theta ln 2 / zeta^2 - mu u} for u >= h_{N+1}, with
+        // w = (kappa theta T + v0 tanh(gamma_{N+1} T / 2)) / zeta^2 and mu = w zeta sqrt(1 - rho^2).
+        // Term n of series t is worth at most scale 2 P_t(h_n) |phi(h_n)| |g_n|, with
+        // |g_n| <= (e^a + K / h_n + K) / (1 + h_n^2) decreasing in h_n, so past N the terms shrink
+        // by at least (1 + 1 / (N + 1))^degree e^{-mu dh} each and their sum is bounded by a
+        // geometric series.
+        int boundedTermCount(const HestonParameters& parameters, SeriesKind kind, double a, double b,
+                             double tolerance, double maxStrike) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            const double zeta2 = zeta * zeta;
+            const double spread = zeta * sqrt(std::max(0.0, 1.0 - rho * rho));
+            const double scale = exp(-r * T) / (b - a);
+            const double expA = exp(a);
+            const double dh = M_PI / (b - a);
+            const std::size_t numTerms = (kind == SeriesKind::Price) ? 1 : TermCount;
+            const std::array<int, TermCount> degrees = seriesDegrees(kind);
+            if (!(spread > 0.0) || !(kappa > 0.0)) {
+                return MaxAdaptiveTerms;
+            }
+            for (int N = 1; N < MaxAdaptiveTerms; ++N) {
+                const double h = (N + 1) * dh;
+                const double gamma = sqrt(kappa * kappa + spread * spread * h * h);
+                const double w = (kappa * theta * T + v0 * tanh(0.5 * gamma * T)) / zeta2;
+                const double mu = w * spread;
+                const double logEnvelope = w * kappa + 2.0 * kappa * theta / zeta2 * M_LN2 - mu * h;
+                const double strikeFactor = (expA + maxStrike / h + maxStrike) / (1.0 + h * h);
+                const std::array<double, TermCount> factors = seriesFactors(h, kind, parameters);
+                bool bounded = true;
+                for (std::size_t t = 0; t < numTerms && bounded; ++t) {
+                    const double ratio = pow(1.0 + 1.0 / (N + 1), degrees[t]) * exp(-mu * dh);
+                    const double first = scale * 2.0 * factors[t] * strikeFactor * exp(logEnvelope);
+                    bounded = ratio < 1.0 && first / (1.0 - ratio) < 0.5 * tolerance;
+                }
+                if (bounded) {
+                    return N;
+                }
+            }
+            return MaxAdaptiveTerms;
+        }
+
+        // With a tolerance, the range comes from truncationRange and the series keeps the
+        // boundedTermCount terms that hold every series within half the tolerance; otherwise the
+        // fixed 24-sigma range and 1021 terms are used. A given `range` replaces either.
+        CosSeries cosSeries(const HestonParameters& parameters, SeriesKind kind = SeriesKind::Price,
+                            double tolerance = 0.0, double maxStrike = 0.0,
+                            std::optional<std::pair<double, double>> range = std::nullopt) {
+            auto [kappa, theta, zeta, rho, v0, r, T, K, S] = parameters;
+            const auto [c1, c2] = logSpotCumulants(parameters);
+
+            const bool adaptive = tolerance > 0.0;
+            CosSeries series;
+            if (range) {
+                std::tie(series.a, series.b) = *range;
+            } else if (adaptive) {
+                std::tie(series.a, series.b) = truncationRange(parameters, tolerance, maxStrike, c1, c2);
+            } else {
+                std::tie(series.a, series.b) = fixedRange(parameters);
+            }
+            series.numTerms = (kind == SeriesKind::Price) ? 1 : TermCount;
+            series.count = adaptive ? boundedTermCount(parameters, kind, series.a, series.b, tolerance, maxStrike)
+                                    : NumTerms;
+            series.weights.resize(series.count * series.numTerms);
+
+            const double dh = M_PI / (series.b - series.a);
+            const complex<double> rotation = exp(complex<double>(0, -1) * series.a * dh);
+            complex<double> shift = 2.0;
+            std::array<complex<double>, TermCount> X;
+            for (int n = 1; n <= series.count; ++n) {
+                double h_n = n * dh;
+                shift *= rotation;      // 2 e^{-i a h_n}
+                if (kind == SeriesKind::Price) {
+                    X[Value] = characteristicFunction(h_n, parameters);
+                } else if (kind == SeriesKind::ParameterGradient) {
+                    const DualComplex dual = characteristicFunctionGradient(h_n, parameters);
+                    X[Value] = dual.value;
+                    for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                        X[1 + j] = dual.gradient[j];
+                    }
+                } else {
+                    // phi is proportional to S^{i u} and e^{i u r T}
+                    const CharacteristicTerms terms = characteristicTerms(h_n, parameters);
+                    const complex<double> iu(0.0, h_n);
+                    X[Value] = terms.phi;
+                    X[DSpot] = iu / S * terms.phi;
+                    X[DSpotSpot] = (iu * iu - iu) / (S * S) * terms.phi;
+                    X[DVariance] = terms.dPhiDVariance;
+                    X[DExpiry] = terms.dPhiDExpiry;
+                    X[DRate] = iu * T * terms.phi;
+                }
+                double* w = &series.weights[(n - 1) * series.numTerms];
+                for (std::size_t t = 0; t < series.numTerms; ++t) {
+                    w[t] = real(X[t] * shift);
+                }
+            }
+            return series;
+        }
+
+        // Undiscounted put sums times (b - a): the dot products of the series weights with the
+        // cosine coefficients g_n(K) of the put payoff, all accumulated in one pass over n. The
+        // payoff is integrated over [a, c] with c = ln K clamped to the range, and the sines and
+        // cosines of n h_1 (c - a) come from the angle-addition recurrence.
+        TermSums putSums(const CosSeries& series, double K) {
+            const double a = series.a, b = series.b;
+            const double c = std::clamp(log(K), a, b);
+            const double expA = exp(a), expC = exp(c);
+            const double dh = M_PI / (b - a);
+            const double stepCos = cos(dh * (c - a)), stepSin = sin(dh * (c - a));
+            const std::size_t numTerms = series.numTerms;
+            TermSums sums{};
+            sums[Value] = K * (c - a) - expC + expA;
+            double cosine = 1.0, sine = 0.0;
+            for (int n = 1; n <= series.count; ++n) {
+                const double nextCosine = cosine * stepCos - sine * stepSin;
+                sine = sine * stepCos + cosine * stepSin;
+                cosine = nextCosine;
+                double h_n = n * dh;
+                double g_n = K * sine / h_n - (expC * (cosine + h_n * sine) - expA) / (1 + h_n * h_n);
+                const double* w = &series.weights[(n - 1) * numTerms];
+                for (std::size_t term = 0; term < numTerms; ++term) {
+                    sums[term] += w[term] * g_n;
+                }
+            }
+            return sums;
+        }
+
+        double fromPutSum(const CosSeries& series, double sum, double S, double K, double r, double T, OptionType type) {
+            double price = exp(-r * T) / (series.b - series.a) * sum;
+            if (type == OptionType::Call) {
+                // Put-call parity
+                price += S - K * exp(-r * T);
+            }
+            return max(0.0, price);
+        }
+
+    } // namespace
+
+    Heston::Heston(ExecutionContext context)
+        : Model(std::move(context)) {}
+
+    // Fourier (COS) implementation of Heston price
+    double Heston::price(const Option& option) const {
+        requireVanilla(option, "Heston");
+        requireEuropean(option, "Heston");
+        const MarketSnapshot market = option.getAsset()->snapshot();
+        const double K = option.getStrikePrice();
+        const CosSeries series = cosSeries(getHestonParameters(market, option), SeriesKind::Price, tolerance, K);
+        return fromPutSum(series, putSums(series, K)[Value], market.spotPrice, K, market.get(Param::riskFreeRate),
+                          option.getTimeToExpiry(), option.getType());
     }
 
-    double Heston::computeGreek(const Option& option, GreekType greekType) const {
-        switch (greekType) {
-            case GreekType::Delta:
-                return calculateDelta(option);
-            case GreekType::Gamma:
-                return calculateGamma(option);
-            case GreekType::Vega:
-                return calculateVega(option);
-            case GreekType::Theta:
-                return calculateTheta(option);
-            case GreekType::Rho:
-                return calculateRho(option);
-            default:
-                throw std::invalid_argument("Unsupported Greek type");
+    std::vector<double> Heston::priceChain(const Asset& asset, double expiry, std::span<const double> strikes, OptionType type) const {
+        const MarketSnapshot market = asset.snapshot();
+        const double maxStrike = strikes.empty() ? 0.0 : *std::max_element(strikes.begin(), strikes.end());
+        const CosSeries series = cosSeries(getHestonParameters(market, expiry, 0.0), SeriesKind::Price, tolerance, maxStrike);
+        const double S = market.spotPrice;
+        const double r = market.get(Param::riskFreeRate);
+
+        // Row k of the strike-by-term matrix holds the cosine coefficients g_n(K_k); each price
+        // is that row dotted with the shared weights, so phi is evaluated N times in total
+        std::vector<double> prices(strikes.size());
+        context.parallelFor(0, strikes.size(), 16, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) {
+                prices[k] = fromPutSum(series, putSums(series, strikes[k])[Value], S, strikes[k], r, expiry, type);
+            }
+        });
+        return prices;
+    }
+
+    void Heston::priceBatch(const OptionBatch& batch, std::span<double> prices) const {
+        for (const Option* option : batch.options) {
+            requireVanilla(*option, "Heston");
+            requireEuropean(*option, "Heston");
+        }
+
+        // Sort the rows into chains of equal expiry and type
+        std::vector<std::size_t> order(batch.options.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return std::make_pair(batch.expiry[a], batch.type[a]) < std::make_pair(batch.expiry[b], batch.type[b]);
+        });
+
+        std::vector<double> strikes;
+        for (std::size_t first = 0; first < order.size();) {
+            const double expiry = batch.expiry[order[first]];
+            const OptionType type = batch.type[order[first]];
+            std::size_t last = first;
+            strikes.clear();
+            while (last < order.size() && batch.expiry[order[last]] == expiry && batch.type[order[last]] == type) {
+                strikes.push_back(batch.strike[order[last++]]);
+            }
+            const std::vector<double> chain = priceChain(*batch.asset, expiry, strikes, type);
+            for (std::size_t k = 0; k < chain.size(); ++k) {
+                prices[order[first + k]] = chain[k];
+            }
+            first = last;
         }
     }
 
-    double Heston::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
-        throw std::logic_error("Heston::VaR is not yet implemented.");
+    bool Heston::pricesWholeBatches() const {
+        // One characteristic function per chain, with the strikes spread over the context
+        return true;
     }
 
-    double Heston::ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const {
-        throw std::logic_error("Heston::ExpectedShortfall is not yet implemented.");
+    Valuation Heston::priceWithGreeks(const Option& option, GreekMask) const {
+        requireVanilla(option, "Heston");
+        requireEuropean(option, "Heston");
+        const MarketSnapshot market = option.getAsset()->snapshot();
+        const CosSeries series = cosSeries(getHestonParameters(market, option), SeriesKind::Greeks, tolerance,
+                                           option.getStrikePrice());
+        const double S = market.spotPrice;
+        const double r = market.get(Param::riskFreeRate);
+        const double sigma = market.get(Param::volatility);
+        const double K = option.getStrikePrice();
+        const double T = option.getTimeToExpiry();
+        const TermSums sums = putSums(series, K);
+
+        // Greeks of the put, then put-call parity; the truncation range is held fixed
+        const double discount = exp(-r * T);
+        const double scale = discount / (series.b - series.a);
+        const double put = scale * sums[Value];
+        Valuation valuation;
+        valuation.price = fromPutSum(series, sums[Value], S, K, r, T, option.getType());
+        valuation.greeks.delta = scale * sums[DSpot];
+        valuation.greeks.gamma = scale * sums[DSpotSpot];
+        valuation.greeks.vega = 2.0 * sigma * scale * sums[DVariance];     // d/dsigma with v0 = sigma^2
+        valuation.greeks.theta = r * put - scale * sums[DExpiry];
+        valuation.greeks.rho = -T * put + scale * sums[DRate];
+        if (option.getType() == OptionType::Call) {
+            valuation.greeks.delta += 1.0;
+            valuation.greeks.theta -= r * K * discount;
+            valuation.greeks.rho += K * T * discount;
+        }
+        return valuation;
     }
 
-    double Heston::calculateDelta(const Option& option) {
-        throw std::logic_error("Heston::calculateDelta is not yet implemented.");
+    std::pair<double, double> hestonTruncationRange(const MarketSnapshot& market, double expiry) {
+        return fixedRange(getHestonParameters(market, expiry, 0.0));
     }
 
-    double Heston::calculateGamma(const Option& option) {
-        throw std::logic_error("Heston::calculateGamma is not yet implemented.");
+    void hestonPutChainGradient(const MarketSnapshot& market, double expiry, std::pair<double, double> range,
+                                std::span<const double> strikes, std::span<double> prices, std::span<double> gradients) {
+        const CosSeries series = cosSeries(getHestonParameters(market, expiry, 0.0), SeriesKind::ParameterGradient,
+                                           0.0, 0.0, range);
+        const double scale = exp(-market.get(Param::riskFreeRate) * expiry) / (series.b - series.a);
+        for (std::size_t k = 0; k < strikes.size(); ++k) {
+            const TermSums sums = putSums(series, strikes[k]);
+            prices[k] = scale * sums[Value];
+            for (std::size_t j = 0; j < NumCalibratedParameters; ++j) {
+                gradients[k * NumCalibratedParameters + j] = scale * sums[1 + j];
+            }
+        }
     }
 
-    double Heston::calculateVega(const Option& option) {
-        throw std::logic_error("Heston::calculateVega is not yet implemented.");
+    double Heston::computeGreek(const Option& option, GreekType greekType) const {
+        return computeGreeks(option, greekBit(greekType)).get(greekType);
     }
 
-    double Heston::calculateTheta(const Option& option) {
-        throw std::logic_error("Heston::calculateTheta is not yet implemented.");
+    Greeks Heston::computeGreeks(const Option& option, GreekMask mask) const {
+        // Every Greek comes from the same pass over the series, so compute them all and mask
+        Greeks all = priceWithGreeks(option).greeks;
+        Greeks greeks;
+        for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+            if (mask & greekBit(type)) {
+                greeks.set(type, all.get(type));
+            }
+        }
+        return greeks;
+    }
+
+    double Heston::getTolerance() const {
+        return tolerance;
     }
 
-    double Heston::calculateRho(const Option& option) {
-        throw std::logic_error("Heston::calculateRho is not yet implemented.");
+    void Heston::setTolerance(double newTolerance) {
+        tolerance = std::max(newTolerance, 0.0);
+    }
+
+    double Heston::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        throw std::logic_error("Heston::VaR is not yet implemented.");
+    }
+
+    double Heston::ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        throw std::logic_error("Heston::ExpectedShortfall is not yet implemented.");
     }
 
 } // namespace OptionLib::Models
@@ -0,0 +1,254 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/models/HestonCalibrator.h>
+#include <OptionLib/models/BlackScholes.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "HestonFourier.h"
+
+namespace OptionLib::Models {
+
+    HestonCalibrator::HestonCalibrator(ExecutionContext context)
+        : context(std::move(context)) {}
+
+    HestonCalibrator::HestonCalibrator(Settings settings, ExecutionContext context)
+        : settings(settings), context(std::move(context)) {}
+
+    namespace {
+
+        constexpr std::size_t P = NumCalibratedParameters;
+        using Vector = std::array<double, P>;
+        using Matrix = std::array<std::array<double, P>, P>;
+
+        constexpr Param calibratedParams[P] = {Param::volatility, Param::meanReversion, Param::longTermVariance,
+                                               Param::volOfVol, Param::hestonCorrelation};
+
+        // Box constraints keeping every trial point a valid Heston model
+        constexpr Vector lowerBounds = {1e-3, 1e-3, 1e-4, 1e-3, -0.999};
+        constexpr Vector upperBounds = {5.0, 50.0, 4.0, 5.0, 0.999};
+
+        HestonCalibrator::Parameters fromVector(const Vector& x) {
+            return {x[0], x[1], x[2], x[3], x[4]};
+        }
+
+        // Solves A x = b by Gaussian elimination with partial pivoting; false if A is singular
+        bool solve(Matrix A, Vector b, Vector& x) {
+            for (std::size_t col = 0; col < P; ++col) {
+                std::size_t pivot = col;
+                for (std::size_t row = col + 1; row < P; ++row) {
+                    if (std::abs(A[row][col]) > std::abs(A[pivot][col])) {
+                        pivot = row;
+                    }
+                }
+                if (A[pivot][col] == 0.0) {
+                    return false;
+                }
+                std::swap(A[col], A[pivot]);
+                std::swap(b[col], b[pivot]);
+                for (std::size_t row = col + 1; row < P; ++row) {
+                    double factor = A[row][col] / A[col][col];
+                    for (std::size_t k = col; k < P; ++k) {
+                        A[row][k] -= factor * A[col][k];
+                    }
+                    b[row] -= factor * b[col];
+                }
+            }
+            for (std::size_t row = P; row-- > 0;) {
+                double sum = b[row];
+                for (std::size_t k = row + 1; k < P; ++k) {
+                    sum -= A[row][k] * x[k];
+                }
+                x[row] = sum / A[row][row];
+            }
+            return true;
+        }
+
+        // Quotes sharing one expiry, priced together
+        struct ExpirySlice {
+            double expiry;
+            std::vector<std::size_t> quotes;
+            std::vector<double> strikes;
+        };
+
+    } // namespace
+
+    HestonCalibrator::Result HestonCalibrator::calibrate(Asset& asset, std::span<const VolatilityQuote> quotes) const {
+        const auto start = std::chrono::steady_clock::now();
+        if (quotes.empty()) {
+            throw std::invalid_argument("HestonCalibrator::calibrate: no quotes");
+        }
+        MarketSnapshot market = asset.snapshot();
+        const double S = market.spotPrice;
+        const double r = market.get(Param::riskFreeRate);
+        const std::size_t m = quotes.size();
+
+        // Market prices and the vegas that turn price errors into implied-volatility errors
+        std::vector<double> spots(m, S), strikes(m), expiries(m), vols(m), rates(m, r);
+        std::vector<OptionType> types(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            strikes[i] = quotes[i].strike;
+            expiries[i] = quotes[i].expiry;
+            vols[i] = quotes[i].impliedVolatility;
+            types[i] = quotes[i].type;
+        }
+        std::vector<double> marketPrices(m), vegas(m);
+        BlackScholes::priceBatch({spots, strikes, expiries, vols, rates, types}, {.price = marketPrices, .vega = vegas});
+        std::vector<double> weights(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            weights[i] = 1.0 / std::max(vegas[i], 1e-3 * S);
+        }
+
+        std::vector<std::size_t> order(m);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) { return expiries[i] < expiries[j]; });
+        std::vector<ExpirySlice> slices;
+        for (std::size_t i : order) {
+            if (slices.empty() || slices.back().expiry != expiries[i]) {
+                slices.push_back({expiries[i], {}, {}});
+            }
+            slices.back().quotes.push_back(i);
+            slices.back().strikes.push_back(strikes[i]);
+        }
+
+        // Residuals and their Jacobian at x, one slice per task. Each slice's truncation range is
+        // frozen at the starting parameters (see below), so the fitted prices are a smooth function
+        // of the parameters and the Jacobian is their exact derivative.
+        std::vector<std::pair<double, double>> ranges(slices.size());
+        Result result;
+        std::vector<double> residuals(m), jacobian(m * P);
+        auto evaluate = [&](const Vector& x, std::vector<double>& res, std::vector<double>& jac) {
+            MarketSnapshot trial = market;
+            for (std::size_t j = 0; j < P; ++j) {
+                trial.parameters[static_cast<std::size_t>(calibratedParams[j])] = x[j];
+                trial.validMask |= 1u << static_cast<unsigned int>(calibratedParams[j]);
+            }
+            context.parallelFor(0, slices.size(), 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t s = begin; s < end; ++s) {
+                    const ExpirySlice& slice = slices[s];
+                    const std::size_t n = slice.quotes.size();
+                    std::vector<double> puts(n), gradients(n * P);
+                    hestonPutChainGradient(trial, slice.expiry, ranges[s], slice.strikes, puts, gradients);
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const std::size_t i = slice.quotes[k];
+                        double model = puts[k];
+                        if (types[i] == OptionType::Call) {
+                            model += S - strikes[i] * std::exp(-r * slice.expiry);
+                        }
+                        res[i] = weights[i] * (model - marketPrices[i]);
+                        for (std::size_t j = 0; j < P; ++j) {
+                            jac[i * P + j] = weights[i] * gradients[k * P + j];
+                        }
+                    }
+                }
+            });
+            ++result.evaluations;
+            double cost = 0.0;
+            for (double e : res) {
+                cost += e * e;
+            }
+            return cost;
+        };
+
+        // Warm start from the asset's parameters, or a generic guess around the quoted level
+        Vector x;
+        if (std::all_of(std::begin(calibratedParams), std::end(calibratedParams), [&](Param p) { return market.has(p); })) {
+            for (std::size_t j = 0; j < P; ++j) {
+                x[j] = market.get(calibratedParams[j]);
+            }
+        } else {
+            double level = std::accumulate(vols.begin(), vols.end(), 0.0) / static_cast<double>(m);
+            x = {level, 1.5, level * level, 0.5, -0.5};
+        }
+        for (std::size_t j = 0; j < P; ++j) {
+            x[j] = std::clamp(x[j], lowerBounds[j], upperBounds[j]);
+        }
+
+        MarketSnapshot initial = market;
+        for (std::size_t j = 0; j < P; ++j) {
+            initial.parameters[static_cast<std::size_t>(calibratedParams[j])] = x[j];
+            initial.validMask |= 1u << static_cast<unsigned int>(calibratedParams[j]);
+        }
+        for (std::size_t s = 0; s < slices.size(); ++s) {
+            ranges[s] = hestonTruncationRange(initial, slices[s].expiry);
+        }
+
+        double cost = evaluate(x, residuals, jacobian);
+        double damping = settings.initialDamping;
+        std::vector<double> trialResiduals(m), trialJacobian(m * P);
+        while (result.iterations < settings.maxIterations && cost > 0.0) {
+            // Normal equations (J^T J + damping diag(J^T J)) dx = -J^T r
+            Matrix normal{};
+            Vector gradient{};
+            for (std::size_t i = 0; i < m; ++i) {
+                const double* row = &jacobian[i * P];
+                for (std::size_t j = 0; j < P; ++j) {
+                    gradient[j] += row[j] * residuals[i];
+                    for (std::size_t k = 0; k < P; ++k) {
+                        normal[j][k] += row[j] * row[k];
+                    }
+                }
+            }
+            Matrix damped = normal;
+            Vector rhs;
+            for (std::size_t j = 0; j < P; ++j) {
+                damped[j][j] += damping * std::max(normal[j][j], 1e-12);
+                rhs[j] = -gradient[j];
+            }
+
+            ++result.iterations;
+            Vector step, trial;
+            if (!solve(damped, rhs, step)) {
+                damping *= 4.0;
+                continue;
+            }
+            for (std::size_t j = 0; j < P; ++j) {
+                trial[j] = std::clamp(x[j] + step[j], lowerBounds[j], upperBounds[j]);
+            }
+
+            double trialCost = evaluate(trial, trialResiduals, trialJacobian);
+            if (trialCost < cost) {
+                const bool small = (cost - trialCost) <= settings.tolerance * cost;
+                x = trial;
+                cost = trialCost;
+                residuals.swap(trialResiduals);
+                jacobian.swap(trialJacobian);
+                damping = std::max(damping / 3.0, 1e-12);
+                if (small) {
+                    result.converged = true;
+                    break;
+                }
+            } else {
+                damping *= 4.0;
+                if (damping > 1e12) {
+                    // No descent left at any step length: x is a local minimum to working precision
+                    result.converged = true;
+                    break;
+                }
+            }
+        }
+
+        for (std::size_t j = 0; j < P; ++j) {
+            asset.set(calibratedParams[j], x[j]);
+        }
+        result.parameters = fromVector(x);
+        result.rootMeanSquareError = std::sqrt(cost / static_cast<double>(m));
+        result.converged = result.converged || cost == 0.0;
+        result.wallTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        return result;
+    }
+
+    const HestonCalibrator::Settings& HestonCalibrator::getSettings() const {
+        return settings;
+    }
+
+    void HestonCalibrator::setSettings(const Settings& newSettings) {
+        settings = newSettings;
+    }
+
+} // namespace OptionLib::Models
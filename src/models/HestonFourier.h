@@ -0,0 +1,34 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef OPTIONLIB_MODELS_HESTONFOURIER_H
+#define OPTIONLIB_MODELS_HESTONFOURIER_H
+
+// Internal entry points into the Heston Fourier pricer for the calibrator
+
+#include <OptionLib/Asset.h>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace OptionLib::Models {
+
+    // Parameters differentiated by hestonPutChainGradient, in this order: volatility (sqrt v0),
+    // meanReversion, longTermVariance, volOfVol, hestonCorrelation
+    inline constexpr std::size_t NumCalibratedParameters = 5;
+
+    // COS truncation range [a, b] of ln S_T at one expiry: the fixed 24-sigma range of the pricer
+    std::pair<double, double> hestonTruncationRange(const MarketSnapshot& market, double expiry);
+
+    // Put prices of the strikes at one expiry, as Heston::priceChain but without the floor at
+    // zero and on the given truncation range, with their gradients in the calibrated parameters
+    // (gradients[k * 5 + j]). The range is held fixed, so the gradients are the exact derivatives
+    // of these prices; a range that moved with the parameters would add terms they leave out.
+    // The characteristic function and its gradient are evaluated once for the whole chain.
+    void hestonPutChainGradient(const MarketSnapshot& market, double expiry, std::pair<double, double> range,
+                                std::span<const double> strikes, std::span<double> prices, std::span<double> gradients);
+
+} // namespace OptionLib::Models
+
+#endif //OPTIONLIB_MODELS_HESTONFOURIER_H
@@ -0,0 +1,357 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/models/HestonMonteCarlo.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <OptionLib/PathPayoff.h>
+#include <OptionLib/random/Philox.h>
+#include "MonteCarloEngine.h"
+#include "simd/Kernels.h"
+
+namespace OptionLib::Models {
+
+    using Checkpoint = MonteCarlo::Checkpoint;
+
+    HestonMonteCarlo::HestonMonteCarlo(ExecutionContext context)
+        : Model(std::move(context)) {}
+
+    HestonMonteCarlo::HestonMonteCarlo(MonteCarlo::Settings settings, ExecutionContext context)
+        : Model(std::move(context)), settings(settings) {}
+
+    namespace {
+
+        // Above this ratio psi = s^2 / m^2 the QE scheme samples the exponential branch
+        constexpr double CriticalPsi = 1.5;
+
+        // Coefficients of one QE step of length dt, shared by every path. Andersen (2008) with
+        // gamma1 = gamma2 = 1/2 (central discretisation of the integrated variance).
+        struct QEStep {
+            double decay;                   // e^{-kappa dt}
+            double meanFromTheta;           // theta (1 - e^{-kappa dt})
+            double varianceFromV;           // s^2 = varianceFromV v + varianceFromTheta
+            double varianceFromTheta;
+            double drift;                   // r dt
+            double K0, K1, K2, K3, K4;
+            double A;                       // K2 + K4 / 2
+            double correctionFromV;         // K1 + K3 / 2
+
+            QEStep(double kappa, double theta, double zeta, double rho, double rate, double dt) {
+                decay = std::exp(-kappa * dt);
+                meanFromTheta = theta * (1.0 - decay);
+                varianceFromV = zeta * zeta * decay * (1.0 - decay) / kappa;
+                varianceFromTheta = theta * zeta * zeta * (1.0 - decay) * (1.0 - decay) / (2.0 * kappa);
+                drift = rate * dt;
+                K0 = -rho * kappa * theta * dt / zeta;
+                K1 = 0.5 * dt * (kappa * rho / zeta - 0.5) - rho / zeta;
+                K2 = 0.5 * dt * (kappa * rho / zeta - 0.5) + rho / zeta;
+                K3 = 0.5 * dt * (1.0 - rho * rho);
+                K4 = K3;
+                A = K2 + 0.5 * K4;
+                correctionFromV = K1 + 0.5 * K3;
+            }
+        };
+
+        // Advances n paths by one QE step. Zv drives the variance, Zs the log-spot's independent
+        // part; the correlation enters through K1 and K2. `integrated` accrues the trapezoidal
+        // integral of the variance.
+        void advance(const QEStep& c, const double* Zv, const double* Zs, double sign, std::size_t n,
+                     double* variance, double* logSpot, double* integrated, double dt) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const double v = variance[i];
+                const double m = c.meanFromTheta + v * c.decay;
+                const double s2 = c.varianceFromTheta + v * c.varianceFromV;
+                const double psi = s2 / (m * m);
+                const double zv = sign * Zv[i];
+
+                double next, K0;
+                if (psi <= CriticalPsi) {
+                    const double twoOverPsi = 2.0 / psi;
+                    const double b2 = twoOverPsi - 1.0 + std::sqrt(twoOverPsi * (twoOverPsi - 1.0));
+                    const double a = m / (1.0 + b2);
+                    const double b = std::sqrt(b2);
+                    next = a * (b + zv) * (b + zv);
+                    const double denominator = 1.0 - 2.0 * c.A * a;
+                    K0 = denominator > 0.0
+                        ? -c.A * b2 * a / denominator + 0.5 * std::log(denominator) - c.correctionFromV * v
+                        : c.K0;
+                } else {
+                    const double p = (psi - 1.0) / (psi + 1.0);
+                    const double beta = (1.0 - p) / m;
+                    const double survival = 0.5 * std::erfc(zv * M_SQRT1_2);     // 1 - U with U = N(zv)
+                    next = survival >= 1.0 - p ? 0.0 : std::log((1.0 - p) / survival) / beta;
+                    K0 = beta > c.A
+                        ? -std::log(p + beta * (1.0 - p) / (beta - c.A)) - c.correctionFromV * v
+                        : c.K0;
+                }
+
+                logSpot[i] += c.drift + K0 + c.K1 * v + c.K2 * next
+                            + std::sqrt(c.K3 * v + c.K4 * next) * sign * Zs[i];
+                integrated[i] += 0.5 * (v + next) * dt;
+                variance[i] = next;
+            }
+        }
+
+        // Simulates Heston paths, ChunkSize at a time, with variance and log-spot in SoA buffers.
+        // Step k of path p uses Philox pair k of its stream: the cosine normal drives the
+        // variance and the sine normal the spot. Dates with a path payoff are the payoff's
+        // monitoring dates; a vanilla has a single date at expiry.
+        struct HestonPathSimulator {
+            const PathPayoff* payoff;
+            double spot, variance, strike, expiry;
+            QEStep step;
+            OptionType type;
+            std::uint64_t seed;
+            std::size_t stepsPerDate;
+            bool antithetic;
+
+            // Calls f(payoff, terminal, n) per chunk, each averaged over the antithetic pair
+            template <typename F>
+            void operator()(std::uint64_t pathBegin, std::uint64_t pathEnd, F&& f) const {
+                const std::size_t dates = payoff ? payoff->getNumObservations() : 1;
+                const double dateDt = expiry / static_cast<double>(dates);
+                const double dt = dateDt / static_cast<double>(stepsPerDate);
+                const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+                const auto philoxNormals = Simd::kernels().philoxNormals;
+                const auto key = Random::Philox4x32::makeKey(seed);
+
+                std::vector<double> variances(detail::ChunkSize), logSpots(detail::ChunkSize), integrated(detail::ChunkSize);
+                std::vector<double> previous(detail::ChunkSize), current(detail::ChunkSize), meanVariance(detail::ChunkSize);
+                std::vector<double> cosine(detail::ChunkSize), sine(detail::ChunkSize);
+                std::vector<double> state(payoff ? payoff->stateSize() * detail::ChunkSize : 0), settled(detail::ChunkSize);
+                std::vector<double> payoffs(detail::ChunkSize), terminals(detail::ChunkSize);
+
+                for (std::uint64_t chunk = pathBegin; chunk < pathEnd; chunk += detail::ChunkSize) {
+                    const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(detail::ChunkSize, pathEnd - chunk));
+
+                    std::fill(payoffs.begin(), payoffs.begin() + n, 0.0);
+                    std::fill(terminals.begin(), terminals.begin() + n, 0.0);
+                    for (int mirror = 0; mirror < (antithetic ? 2 : 1); ++mirror) {
+                        std::fill(variances.begin(), variances.begin() + n, variance);
+                        std::fill(logSpots.begin(), logSpots.begin() + n, std::log(spot));
+                        std::fill(previous.begin(), previous.begin() + n, spot);
+                        if (payoff) {
+                            payoff->start(spot, n, state.data());
+                        }
+
+                        for (std::size_t date = 0; date < dates; ++date) {
+                            std::fill(integrated.begin(), integrated.begin() + n, 0.0);
+                            for (std::size_t s = 0; s < stepsPerDate; ++s) {
+                                philoxNormals({{key[0], key[1]}, chunk, date * stepsPerDate + s, n, cosine.data(), sine.data()});
+                                advance(step, cosine.data(), sine.data(), detail::drawSigns[mirror], n,
+                                        variances.data(), logSpots.data(), integrated.data(), dt);
+                            }
+                            for (std::size_t i = 0; i < n; ++i) {
+                                current[i] = std::exp(logSpots[i]);
+                            }
+                            if (payoff) {
+                                for (std::size_t i = 0; i < n; ++i) {
+                                    meanVariance[i] = integrated[i] / dateDt;
+                                }
+                                payoff->observe({date, static_cast<double>(date + 1) * dateDt, dateDt, std::sqrt(variance),
+                                                 previous.data(), current.data(), n, meanVariance.data()},
+                                                state.data());
+                            }
+                            std::swap(previous, current);
+                        }
+
+                        if (payoff) {
+                            payoff->settle(strike, type, n, previous.data(), state.data(), settled.data());
+                        } else {
+                            for (std::size_t i = 0; i < n; ++i) {
+                                settled[i] = std::max(phi * (previous[i] - strike), 0.0);
+                            }
+                        }
+                        for (std::size_t i = 0; i < n; ++i) {
+                            payoffs[i] += settled[i];
+                            terminals[i] += previous[i];
+                        }
+                    }
+
+                    if (antithetic) {
+                        for (std::size_t i = 0; i < n; ++i) {
+                            payoffs[i] *= 0.5;
+                            terminals[i] *= 0.5;
+                        }
+                    }
+                    f(payoffs.data(), terminals.data(), n);
+                }
+            }
+        };
+
+    } // namespace
+
+    HestonMonteCarlo::Dynamics HestonMonteCarlo::readDynamics(const MarketSnapshot& market) {
+        const double volatility = market.get(Param::volatility);
+        Dynamics dynamics{market.spotPrice, market.get(Param::riskFreeRate), volatility * volatility,
+                          market.get(Param::meanReversion), market.get(Param::longTermVariance),
+                          market.get(Param::volOfVol), market.get(Param::hestonCorrelation)};
+        if (dynamics.meanReversion <= 0.0 || dynamics.volOfVol <= 0.0) {
+            throw std::invalid_argument("HestonMonteCarlo: mean reversion and vol of vol must be positive");
+        }
+        return dynamics;
+    }
+
+    std::size_t HestonMonteCarlo::stepsPerDate(const Option& option) const {
+        const std::size_t dates = option.isPathDependent() ? option.getPathPayoff()->getNumObservations() : 1;
+        const double steps = std::ceil(option.getTimeToExpiry() * stepsPerYear / static_cast<double>(dates));
+        return std::max<std::size_t>(1, static_cast<std::size_t>(steps));
+    }
+
+    Checkpoint HestonMonteCarlo::priceWrapper(const Option& option, const Dynamics& dynamics, double timeToMaturity,
+                                              std::size_t stepsPerDate, std::uint64_t numSimulations,
+                                              const Checkpoint& from) const {
+        requireEuropean(option, "HestonMonteCarlo");
+        if (settings.sampling != Sampling::PseudoRandom) {
+            throw std::invalid_argument("HestonMonteCarlo supports pseudo-random sampling only");
+        }
+        if (settings.controlVariate == ControlVariate::BlackScholes) {
+            throw std::invalid_argument("HestonMonteCarlo does not support the Black-Scholes control variate");
+        }
+
+        const std::uint64_t pathsPerSample = settings.antithetic ? 2 : 1;
+        if (from.numSamples > 0 && from.pathsPerSample != pathsPerSample) {
+            throw std::invalid_argument("HestonMonteCarlo::simulate: checkpoint was taken with different antithetic settings");
+        }
+        const std::uint64_t numSamples = (numSimulations + pathsPerSample - 1) / pathsPerSample;
+        const double discountFactor = std::exp(-dynamics.rate * timeToMaturity);
+
+        Checkpoint checkpoint;
+        checkpoint.pathsPerSample = pathsPerSample;
+        checkpoint.replicate = from.replicate;
+        checkpoint.discountFactor = discountFactor;
+        const bool withControl = settings.controlVariate == ControlVariate::TerminalSpot;
+        if (withControl) {
+            checkpoint.hasControl = true;
+            checkpoint.controlMean = dynamics.spot / discountFactor;
+        }
+
+        const std::size_t dates = option.isPathDependent() ? option.getPathPayoff()->getNumObservations() : 1;
+        const double dt = timeToMaturity / static_cast<double>(dates * stepsPerDate);
+        const HestonPathSimulator simulator{option.getPathPayoff().get(), dynamics.spot, dynamics.variance,
+                                            option.getStrikePrice(), timeToMaturity,
+                                            QEStep(dynamics.meanReversion, dynamics.longTermVariance, dynamics.volOfVol,
+                                                   dynamics.correlation, dynamics.rate, dt),
+                                            option.getType(), seed, stepsPerDate, pathsPerSample == 2};
+
+        const detail::SampleSums sums = detail::accumulatePaths<detail::SampleSumCount>(context, from.numSamples, numSamples, detail::sampleSums(from),
+                                                                [&](std::uint64_t pathBegin, std::uint64_t pathEnd, detail::SampleSums& acc) {
+            simulator(pathBegin, pathEnd, [&](const double* payoff, const double* terminal, std::size_t n) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    detail::addSample(acc, payoff[i], terminal[i], withControl);
+                }
+            });
+        });
+
+        checkpoint.numSamples = from.numSamples + numSamples;
+        detail::setSampleSums(checkpoint, sums);
+        return checkpoint;
+    }
+
+    Checkpoint HestonMonteCarlo::simulate(const Option& option, std::uint64_t numPaths, const Checkpoint& from) const {
+        return priceWrapper(option, readDynamics(option.getAsset()->snapshot()), option.getTimeToExpiry(),
+                            stepsPerDate(option), numPaths, from);
+    }
+
+    Checkpoint HestonMonteCarlo::simulate(const Option& option, std::uint64_t numPaths) const {
+        return simulate(option, numPaths, Checkpoint{});
+    }
+
+    MonteCarlo::Estimate HestonMonteCarlo::estimate(const Option& option) const {
+        const Dynamics dynamics = readDynamics(option.getAsset()->snapshot());
+        const double T = option.getTimeToExpiry();
+        const std::size_t steps = stepsPerDate(option);
+        return detail::estimateInBatches(context, settings, 1, [&](std::uint64_t numPaths, const Checkpoint& from) {
+            return priceWrapper(option, dynamics, T, steps, numPaths, from);
+        });
+    }
+
+    double HestonMonteCarlo::price(const Option& option) const {
+        return estimate(option).price;
+    }
+
+    double HestonMonteCarlo::computeGreek(const Option& option, GreekType greekType) const {
+        return computeGreeks(option, greekBit(greekType)).get(greekType);
+    }
+
+    Greeks HestonMonteCarlo::computeGreeks(const Option& option, GreekMask mask) const {
+        Greeks all = priceWithGreeks(option).greeks;
+        Greeks greeks;
+        for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+            if (mask & greekBit(type)) {
+                greeks.set(type, all.get(type));
+            }
+        }
+        return greeks;
+    }
+
+    Valuation HestonMonteCarlo::priceWithGreeks(const Option& option, GreekMask) const {
+        const Dynamics base = readDynamics(option.getAsset()->snapshot());
+        const double T = option.getTimeToExpiry();
+        const double sigma = std::sqrt(base.variance);
+
+        // Same bumps as MonteCarlo, all on the same draws and time grid so the noise cancels in
+        // the differences; Theta shortens every step rather than dropping one
+        const double dS = 0.01 * base.spot, dSigma = 0.01, dR = 0.0001, dT = 1.0 / 365;
+        const std::size_t steps = stepsPerDate(option);
+        auto reprice = [&](double spot, double rate, double vol, double expiry) {
+            Dynamics bumped = base;
+            bumped.spot = spot;
+            bumped.rate = rate;
+            bumped.variance = vol * vol;
+            return priceWrapper(option, bumped, expiry, steps, settings.maxPaths, Checkpoint{}).price();
+        };
+
+        const double S = base.spot, r = base.rate;
+        const double center = reprice(S, r, sigma, T);
+        const double spotUp = reprice(S + dS, r, sigma, T);
+        const double spotDown = reprice(S - dS, r, sigma, T);
+
+        Valuation valuation;
+        valuation.price = center;
+        valuation.greeks.delta = (spotUp - spotDown) / (2 * dS);
+        valuation.greeks.gamma = (spotUp - 2 * center + spotDown) / (dS * dS);
+        valuation.greeks.vega = (reprice(S, r, sigma + dSigma, T) - reprice(S, r, std::max(sigma - dSigma, 0.0), T))
+                              / (sigma + dSigma - std::max(sigma - dSigma, 0.0));
+        valuation.greeks.theta = (reprice(S, r, sigma, T - dT) - center) / dT;
+        valuation.greeks.rho = (reprice(S, r + dR, sigma, T) - reprice(S, r - dR, sigma, T)) / (2 * dR);
+        return valuation;
+    }
+
+    const MonteCarlo::Settings& HestonMonteCarlo::getSettings() const {
+        return settings;
+    }
+
+    void HestonMonteCarlo::setSettings(const MonteCarlo::Settings& newSettings) {
+        settings = newSettings;
+    }
+
+    std::uint64_t HestonMonteCarlo::getSeed() const {
+        return seed;
+    }
+
+    void HestonMonteCarlo::setSeed(std::uint64_t newSeed) {
+        seed = newSeed;
+    }
+
+    unsigned HestonMonteCarlo::getStepsPerYear() const {
+        return stepsPerYear;
+    }
+
+    void HestonMonteCarlo::setStepsPerYear(unsigned newStepsPerYear) {
+        stepsPerYear = std::max(newStepsPerYear, 1u);
+    }
+
+    double HestonMonteCarlo::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        throw std::logic_error("HestonMonteCarlo::VaR is not yet implemented.");
+    }
+
+    double HestonMonteCarlo::ExpectedShortfall(const Option& option, double confidenceLevel, double holdingPeriod) const {
+        throw std::logic_error("HestonMonteCarlo::ExpectedShortfall is not yet implemented.");
+    }
+
+} // namespace OptionLib::Models
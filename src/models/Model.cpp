@@ -3,9 +3,94 @@
 //
 
 #include "OptionLib/models/Model.h"
+#include <OptionLib/VolSurface.h>
+#include <stdexcept>
+#include <string>
 
 namespace OptionLib::Models {
 
+        Model::Model(ExecutionContext context)
+            : context(std::move(context)) {}
+
         Model::~Model() = default;
 
+        const ExecutionContext& Model::getExecutionContext() const {
+            return context;
+        }
+
+        void Model::setExecutionContext(ExecutionContext newContext) {
+            context = std::move(newContext);
+        }
+
+        void Model::requireVanilla(const Option& option, const char* modelName) {
+            if (option.isPathDependent()) {
+                throw std::invalid_argument(std::string(modelName) + " prices vanilla options only; use MonteCarlo for path-dependent payoffs.");
+            }
+        }
+
+        void Model::requireEuropean(const Option& option, const char* modelName) {
+            if (option.hasEarlyExercise()) {
+                throw std::invalid_argument(std::string(modelName) + " prices European exercise only; use Binomial for American and Bermudan options.");
+            }
+        }
+
+        double Model::optionVolatility(const Option& option, const MarketSnapshot& market, const VolSurface* surface) {
+            if (surface) {
+                return surface->volatility(option.getStrikePrice(), option.getTimeToExpiry());
+            }
+            return market.get(Param::volatility);
+        }
+
+        double Greeks::get(GreekType type) const {
+            switch (type) {
+                case GreekType::Delta: return delta;
+                case GreekType::Gamma: return gamma;
+                case GreekType::Vega: return vega;
+                case GreekType::Theta: return theta;
+                case GreekType::Rho: return rho;
+                default:
+                    throw std::invalid_argument("Invalid Greek type");
+            }
+        }
+
+        void Greeks::set(GreekType type, double value) {
+            switch (type) {
+                case GreekType::Delta: delta = value; break;
+                case GreekType::Gamma: gamma = value; break;
+                case GreekType::Vega: vega = value; break;
+                case GreekType::Theta: theta = value; break;
+                case GreekType::Rho: rho = value; break;
+                default:
+                    throw std::invalid_argument("Invalid Greek type");
+            }
+        }
+
+        Greeks Model::computeGreeks(const Option& option, GreekMask mask) const {
+            Greeks greeks;
+            for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+                if (mask & greekBit(type)) {
+                    greeks.set(type, computeGreek(option, type));
+                }
+            }
+            return greeks;
+        }
+
+        Valuation Model::priceWithGreeks(const Option& option, GreekMask mask) const {
+            return {price(option), computeGreeks(option, mask)};
+        }
+
+        void Model::priceBatch(const OptionBatch& batch, std::span<double> prices) const {
+            for (std::size_t i = 0; i < batch.options.size(); ++i) {
+                prices[i] = price(*batch.options[i]);
+            }
+        }
+
+        bool Model::pricesWholeBatches() const {
+            return false;
+        }
+
+        double Model::relativeCost() const {
+            return 1000.0;
+        }
+
 } // namespace Models
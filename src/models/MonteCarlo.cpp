@@ -3,121 +3,530 @@
 //
 
 #include <OptionLib/models/MonteCarlo.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
-#include <future>
-#include <random>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 #include <vector>
-#include <chrono>
-#include <iostream>
+#include <OptionLib/PathPayoff.h>
+#include <OptionLib/models/BlackScholes.h>
+#include <OptionLib/random/BrownianBridge.h>
+#include <OptionLib/random/Normal.h>
+#include <OptionLib/random/Philox.h>
+#include <OptionLib/random/Sobol.h>
+#include "MonteCarloEngine.h"
+#include "simd/Kernels.h"
 
 namespace OptionLib::Models {
 
-    double MonteCarlo::priceWrapper(const Option& _option, double _spotPrice, double _riskFreeRate, double _volatility,
-                                    double strikePrice, double timeToMaturity, int _numSimulations) {
+    MonteCarlo::MonteCarlo(ExecutionContext context)
+        : Model(std::move(context)) {}
 
-        double discountFactor = std::exp(-_riskFreeRate * timeToMaturity);
+    MonteCarlo::MonteCarlo(GreekEstimator estimator, ExecutionContext context)
+        : Model(std::move(context)), greekEstimator(estimator) {}
 
-        unsigned int numThreads = std::thread::hardware_concurrency();
-        if (numThreads == 0) numThreads = 2;
+    MonteCarlo::MonteCarlo(Settings settings, ExecutionContext context)
+        : Model(std::move(context)), settings(settings) {}
 
-        int simulationsPerThread = _numSimulations / numThreads;
-        int remainingSimulations = _numSimulations % numThreads;
+    namespace {
 
-        auto monteCarloWorker = [&](int simulations) {
-            std::mt19937 rng(std::random_device{}());
-            std::normal_distribution<> dist(0.0, 1.0);
+        // Feeds the normals driving paths [pathBegin, pathEnd) to f(Z, n) in chunks, in path order.
+        // Pseudo-random paths take the first draw of their own Philox stream, generated a whole
+        // chunk at a time by the SIMD kernel. Quasi-random paths take consecutive points of a one-dimensional Sobol
+        // sequence, entered by skipping straight to pathBegin.
+        struct DrawSource {
+            Sampling sampling;
+            std::uint64_t seed;
+            std::uint32_t replicate;
 
-            double payoffSum = 0.0;
-            for (int i = 0; i < simulations; ++i) {
+            template <typename F>
+            void operator()(std::uint64_t pathBegin, std::uint64_t pathEnd, F&& f) const {
+                alignas(64) double normals[detail::ChunkSize];
+                if (sampling == Sampling::Sobol) {
+                    Random::Sobol sobol(1, seed + replicate);
+                    sobol.skipTo(pathBegin);
+                    for (std::uint64_t chunk = pathBegin; chunk < pathEnd; chunk += detail::ChunkSize) {
+                        const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(detail::ChunkSize, pathEnd - chunk));
+                        for (std::size_t i = 0; i < n; ++i) {
+                            double u;
+                            sobol.next(&u);
+                            normals[i] = Random::inverseNormalCdf(u);
+                        }
+                        f(static_cast<const double*>(normals), n);
+                    }
+                    return;
+                }
 
-                double Z = dist(rng);
-                double ST = _spotPrice * std::exp((_riskFreeRate - 0.5 * _volatility * _volatility) * timeToMaturity + _volatility * std::sqrt(timeToMaturity) * Z);
+                const auto key = Random::Philox4x32::makeKey(seed);
+                const auto philoxNormals = Simd::kernels().philoxNormals;
+                for (std::uint64_t chunk = pathBegin; chunk < pathEnd; chunk += detail::ChunkSize) {
+                    const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(detail::ChunkSize, pathEnd - chunk));
+                    philoxNormals({{key[0], key[1]}, chunk, 0, n, normals, nullptr});
+                    f(static_cast<const double*>(normals), n);
+                }
+            }
+        };
 
-                double payoff = 0.0;
-                if (_option.getType() == OptionType::Call) {
-                    payoff = std::max(ST - strikePrice, 0.0); // Call payoff
-                } else if (_option.getType() == OptionType::Put) {
-                    payoff = std::max(strikePrice - ST, 0.0); // Put payoff
+        // Adapts a per-path body(Z, sums) to a range of paths fed by `draws`
+        template <typename PerPath>
+        auto eachPath(const DrawSource& draws, PerPath perPath) {
+            return [draws, perPath](std::uint64_t pathBegin, std::uint64_t pathEnd, auto& sums) {
+                draws(pathBegin, pathEnd, [&](const double* normals, std::size_t n) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        perPath(normals[i], sums);
+                    }
+                });
+            };
+        }
+
+        // Simulates multi-step paths on the payoff's monitoring dates and settles its payoff. Paths
+        // run ChunkSize at a time, one date after another, so memory is O(ChunkSize * state)
+        // whatever the number of paths. Pseudo-random step k of path p is draw k of its
+        // NormalStream. Quasi-random paths are built by a Brownian bridge from one Sobol point
+        // per path; dates beyond Sobol::MaxDimensions take the remaining bridge normals from the
+        // path's NormalStream.
+        struct PathSimulator {
+            const PathPayoff& payoff;
+            double spot, rate, volatility, expiry, strike;
+            OptionType type;
+            Sampling sampling;
+            std::uint64_t seed;
+            std::uint32_t replicate;
+            bool antithetic;
+
+            // Calls f(payoff, terminal, vanilla, n) per chunk, each averaged over the antithetic pair
+            template <typename F>
+            void operator()(std::uint64_t pathBegin, std::uint64_t pathEnd, F&& f) const {
+                const std::size_t steps = payoff.getNumObservations();
+                const double dt = expiry / static_cast<double>(steps);
+                const double drift = (rate - 0.5 * volatility * volatility) * dt;
+                const double diffusion = volatility * std::sqrt(dt);
+                const double phi = (type == OptionType::Call) ? 1.0 : -1.0;
+                const Simd::KernelTable& kernels = Simd::kernels();
+                const auto key = Random::Philox4x32::makeKey(seed);
+
+                std::vector<double> from(detail::ChunkSize), to(detail::ChunkSize), cosine(detail::ChunkSize), sine(detail::ChunkSize);
+                std::vector<double> state(payoff.stateSize() * detail::ChunkSize), settled(detail::ChunkSize);
+                std::vector<double> payoffs(detail::ChunkSize), terminals(detail::ChunkSize), vanillas(detail::ChunkSize);
+
+                // Quasi-random paths keep every step's normal of the chunk, step-major
+                const bool quasi = (sampling == Sampling::Sobol);
+                const unsigned sobolDimensions = static_cast<unsigned>(std::min<std::size_t>(steps, Random::Sobol::MaxDimensions));
+                std::vector<double> increments, bridgeNormals, bridgePath;
+                std::optional<Random::Sobol> sobol;
+                std::optional<Random::BrownianBridge> bridge;
+                if (quasi) {
+                    increments.resize(steps * detail::ChunkSize);
+                    bridgeNormals.resize(steps);
+                    bridgePath.resize(steps);
+                    sobol.emplace(sobolDimensions, seed + replicate);
+                    sobol->skipTo(pathBegin);
+                    bridge.emplace(steps, expiry);
                 }
 
-                payoffSum += payoff;
+                for (std::uint64_t chunk = pathBegin; chunk < pathEnd; chunk += detail::ChunkSize) {
+                    const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(detail::ChunkSize, pathEnd - chunk));
+
+                    if (quasi) {
+                        std::vector<double> point(sobolDimensions);
+                        for (std::size_t i = 0; i < n; ++i) {
+                            sobol->next(point.data());
+                            for (unsigned d = 0; d < sobolDimensions; ++d) {
+                                bridgeNormals[d] = Random::inverseNormalCdf(point[d]);
+                            }
+                            if (steps > sobolDimensions) {
+                                Random::NormalStream normals(seed, chunk + i);
+                                normals.skipTo(sobolDimensions);
+                                for (std::size_t d = sobolDimensions; d < steps; ++d) {
+                                    bridgeNormals[d] = normals.next();
+                                }
+                            }
+                            bridge->build(bridgeNormals.data(), bridgePath.data());
+                            double previous = 0.0;
+                            for (std::size_t k = 0; k < steps; ++k) {
+                                increments[k * n + i] = (bridgePath[k] - previous) / std::sqrt(dt);
+                                previous = bridgePath[k];
+                            }
+                        }
+                    }
+
+                    std::fill(payoffs.begin(), payoffs.begin() + n, 0.0);
+                    std::fill(terminals.begin(), terminals.begin() + n, 0.0);
+                    std::fill(vanillas.begin(), vanillas.begin() + n, 0.0);
+                    for (int mirror = 0; mirror < (antithetic ? 2 : 1); ++mirror) {
+                        const double signedDiffusion = detail::drawSigns[mirror] * diffusion;
+                        std::fill(from.begin(), from.begin() + n, spot);
+                        payoff.start(spot, n, state.data());
+
+                        for (std::size_t k = 0; k < steps; ++k) {
+                            const double* Z;
+                            if (quasi) {
+                                Z = &increments[k * n];
+                            } else {
+                                if (k % 2 == 0) {
+                                    kernels.philoxNormals({{key[0], key[1]}, chunk, k / 2, n, cosine.data(),
+                                                           k + 1 < steps ? sine.data() : nullptr});
+                                }
+                                Z = (k % 2 == 0) ? cosine.data() : sine.data();
+                            }
+                            kernels.geometricStep({Z, from.data(), to.data(), n, drift, signedDiffusion});
+                            payoff.observe({k, static_cast<double>(k + 1) * dt, dt, volatility, from.data(), to.data(), n},
+                                           state.data());
+                            std::swap(from, to);
+                        }
+
+                        payoff.settle(strike, type, n, from.data(), state.data(), settled.data());
+                        for (std::size_t i = 0; i < n; ++i) {
+                            payoffs[i] += settled[i];
+                            terminals[i] += from[i];
+                            vanillas[i] += std::max(phi * (from[i] - strike), 0.0);
+                        }
+                    }
+
+                    if (antithetic) {
+                        for (std::size_t i = 0; i < n; ++i) {
+                            payoffs[i] *= 0.5;
+                            terminals[i] *= 0.5;
+                            vanillas[i] *= 0.5;
+                        }
+                    }
+                    f(payoffs.data(), terminals.data(), vanillas.data(), n);
+                }
             }
-            return payoffSum;
         };
 
-        std::vector<std::future<double>> futures;
-        for (unsigned int i = 0; i < numThreads; ++i) {
-            int simulations = (i < remainingSimulations) ? simulationsPerThread + 1 : simulationsPerThread;
-            futures.push_back(std::async(std::launch::async, monteCarloWorker, simulations));
+    } // namespace
+
+    double MonteCarlo::Checkpoint::price() const {
+        if (numSamples == 0) {
+            return 0.0;
+        }
+        double n = static_cast<double>(numSamples);
+        double mean = sumX / n;
+        if (hasControl && numSamples > 1) {
+            // Regression estimator: beta = Cov(X, Y) / Var(Y) estimated from the same samples
+            double varY = sumYY / n - (sumY / n) * (sumY / n);
+            double covXY = sumXY / n - mean * (sumY / n);
+            if (varY > 0.0) {
+                mean -= covXY / varY * (sumY / n - controlMean);
+            }
+        }
+        return discountFactor * mean;
+    }
+
+    double MonteCarlo::Checkpoint::standardError() const {
+        if (numSamples < 2) {
+            return std::numeric_limits<double>::infinity();
+        }
+        double n = static_cast<double>(numSamples);
+        double variance = sumXX / n - (sumX / n) * (sumX / n);
+        if (hasControl) {
+            double varY = sumYY / n - (sumY / n) * (sumY / n);
+            double covXY = sumXY / n - (sumX / n) * (sumY / n);
+            if (varY > 0.0) {
+                variance -= covXY * covXY / varY;
+            }
         }
+        return discountFactor * std::sqrt(std::max(variance, 0.0) / (n - 1.0));
+    }
 
-        double totalPayoffSum = 0.0;
-        for (auto& future : futures) {
-            totalPayoffSum += future.get();
+    MonteCarlo::Checkpoint MonteCarlo::priceWrapper(const Option& _option, double _spotPrice, double _riskFreeRate, double _volatility,
+                                                    double strikePrice, double timeToMaturity, std::uint64_t _numSimulations,
+                                                    const Checkpoint& from) const {
+        requireEuropean(_option, "MonteCarlo");
+        const std::uint64_t pathsPerSample = settings.antithetic ? 2 : 1;
+        if (from.numSamples > 0 && from.pathsPerSample != pathsPerSample) {
+            throw std::invalid_argument("MonteCarlo::simulate: checkpoint was taken with different antithetic settings");
         }
+        const std::uint64_t numSamples = (_numSimulations + pathsPerSample - 1) / pathsPerSample;
+
+        double drift = (_riskFreeRate - 0.5 * _volatility * _volatility) * timeToMaturity;
+        double diffusion = _volatility * std::sqrt(timeToMaturity);
+        double discountFactor = std::exp(-_riskFreeRate * timeToMaturity);
+
+        Checkpoint checkpoint;
+        checkpoint.pathsPerSample = pathsPerSample;
+        checkpoint.replicate = from.replicate;
+        checkpoint.discountFactor = discountFactor;
+        // A vanilla's payoff is its own Black-Scholes control, which would only return the closed
+        // form; vanillas take the terminal spot instead
+        ControlVariate control = settings.controlVariate;
+        if (control == ControlVariate::BlackScholes && !_option.isPathDependent()) {
+            control = ControlVariate::TerminalSpot;
+        }
+        switch (control) {
+            case ControlVariate::None:
+                break;
+            case ControlVariate::TerminalSpot:
+                checkpoint.hasControl = true;
+                checkpoint.controlMean = _spotPrice / discountFactor;
+                break;
+            case ControlVariate::BlackScholes: {
+                // At the simulated (possibly bumped) parameters rather than the asset's
+                auto market = std::make_shared<Asset>(_option.getAsset()->getId(), _spotPrice);
+                market->set(Param::volatility, _volatility);
+                market->set(Param::riskFreeRate, _riskFreeRate);
+                const double vanilla = BlackScholes().price(Option(market, strikePrice, timeToMaturity, _option.getType()));
+                checkpoint.hasControl = true;
+                checkpoint.controlMean = vanilla / discountFactor;
+                break;
+            }
+        }
+        const bool withControl = control != ControlVariate::None;
+        const bool spotControl = control == ControlVariate::TerminalSpot;
+
+        const detail::SampleSums resumed = detail::sampleSums(from);
 
-        double averagePayoff = totalPayoffSum / _numSimulations;
-        return averagePayoff * discountFactor;
+        detail::SampleSums sums;
+        if (const auto pathPayoff = _option.getPathPayoff()) {
+            const PathSimulator simulator{*pathPayoff, _spotPrice, _riskFreeRate, _volatility, timeToMaturity, strikePrice,
+                                          _option.getType(), settings.sampling, seed, from.replicate, pathsPerSample == 2};
+            sums = detail::accumulatePaths<detail::SampleSumCount>(context, from.numSamples, numSamples, resumed,
+                                                                   [&](std::uint64_t pathBegin, std::uint64_t pathEnd, detail::SampleSums& acc) {
+                simulator(pathBegin, pathEnd, [&](const double* payoff, const double* terminal, const double* vanilla, std::size_t n) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        detail::addSample(acc, payoff[i], spotControl ? terminal[i] : vanilla[i], withControl);
+                    }
+                });
+            });
+        } else {
+            const auto terminalPayoff = Simd::kernels().terminalPayoff;
+            const DrawSource draws{settings.sampling, seed, from.replicate};
+            sums = detail::accumulatePaths<detail::SampleSumCount>(context, from.numSamples, numSamples, resumed,
+                                                                   [&](std::uint64_t pathBegin, std::uint64_t pathEnd, detail::SampleSums& acc) {
+                draws(pathBegin, pathEnd, [&](const double* normals, std::size_t n) {
+                    alignas(64) double payoff[detail::ChunkSize], terminal[detail::ChunkSize];
+                    terminalPayoff({normals, n, _spotPrice, drift, diffusion, strikePrice, _option.getType(),
+                                    pathsPerSample == 2, payoff, spotControl ? terminal : nullptr});
+                    for (std::size_t i = 0; i < n; ++i) {
+                        detail::addSample(acc, payoff[i], spotControl ? terminal[i] : payoff[i], withControl);
+                    }
+                });
+            });
+        }
+
+        checkpoint.numSamples = from.numSamples + numSamples;
+        detail::setSampleSums(checkpoint, sums);
+        return checkpoint;
+    }
+
+    MonteCarlo::Checkpoint MonteCarlo::simulate(const Option& option, std::uint64_t numPaths, const Checkpoint& from) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        return priceWrapper(option, market.spotPrice, market.get(Param::riskFreeRate), optionVolatility(option, market, surface),
+                            option.getStrikePrice(), option.getTimeToExpiry(), numPaths, from);
+    }
+
+    MonteCarlo::Checkpoint MonteCarlo::simulate(const Option& option, std::uint64_t numPaths) const {
+        return simulate(option, numPaths, Checkpoint{});
+    }
+
+    MonteCarlo::Estimate MonteCarlo::estimate(const Option& option) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        const double S = market.spotPrice;
+        const double r = market.get(Param::riskFreeRate);
+        const double sigma = optionVolatility(option, market, surface);
+        const double K = option.getStrikePrice();
+        const double T = option.getTimeToExpiry();
+
+        // A pseudo-random run is one sample of i.i.d. paths. A quasi-random run is split across
+        // independently shifted Sobol sequences, whose prices are the i.i.d. samples instead.
+        const std::uint32_t numReplicates = (settings.sampling == Sampling::Sobol) ? std::max(settings.randomizations, 2u) : 1u;
+        return detail::estimateInBatches(context, settings, numReplicates, [&](std::uint64_t numPaths, const Checkpoint& from) {
+            return priceWrapper(option, S, r, sigma, K, T, numPaths, from);
+        });
+    }
+
+    const MonteCarlo::Settings& MonteCarlo::getSettings() const {
+        return settings;
+    }
+
+    void MonteCarlo::setSettings(const Settings& newSettings) {
+        settings = newSettings;
+    }
+
+    std::uint64_t MonteCarlo::getSeed() const {
+        return seed;
+    }
+
+    void MonteCarlo::setSeed(std::uint64_t newSeed) {
+        seed = newSeed;
     }
 
     double MonteCarlo::price(const Option& option) const {
-        auto asset = option.getAsset();
-        double K = option.getStrikePrice();
-        double T = option.getTimeToExpiry();
-        return priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), K, T, static_cast<int>(std::pow(10, 7)));
+        return estimate(option).price;
     }
 
     double MonteCarlo::computeGreek(const Option& option, GreekType greekType) const {
-        switch (greekType) {
-            case GreekType::Delta: return calculateDelta(option);
-            case GreekType::Gamma: return calculateGamma(option);
-            case GreekType::Vega: return calculateVega(option);
-            case GreekType::Theta: return calculateTheta(option);
-            case GreekType::Rho: return calculateRho(option);
-            default:
-                throw std::invalid_argument("Invalid Greek type");
+        return computeGreeks(option, greekBit(greekType)).get(greekType);
+    }
+
+    Greeks MonteCarlo::computeGreeks(const Option& option, GreekMask mask) const {
+        Greeks all = priceWithGreeks(option).greeks;
+        Greeks greeks;
+        for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+            if (mask & greekBit(type)) {
+                greeks.set(type, all.get(type));
+            }
         }
+        return greeks;
     }
 
-    double MonteCarlo::calculateDelta(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.01 * asset->getSpotPrice();
-        double pricePlus = priceWrapper(option, asset->getSpotPrice() + epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice() - epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        return (pricePlus - priceMinus) / (2 * epsilon);
+    Valuation MonteCarlo::priceWithGreeks(const Option& option, GreekMask) const {
+        const VolSurface* surface = nullptr;
+        const MarketSnapshot market = option.getAsset()->snapshot(surface);
+        const std::uint64_t numSimulations = settings.maxPaths;
+        requireEuropean(option, "MonteCarlo");
+        if (option.isPathDependent()) {
+            return pathDependentWrapper(option, market, surface, numSimulations);
+        }
+        if (greekEstimator == GreekEstimator::Pathwise) {
+            return pathwiseWrapper(option, market, surface, numSimulations);
+        }
+        return commonRandomNumbersWrapper(option, market, surface, numSimulations);
     }
 
-    double MonteCarlo::calculateGamma(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.01 * asset->getSpotPrice();
-        double pricePlus = priceWrapper(option, asset->getSpotPrice() + epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        double priceCenter = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(),option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice() - epsilon, asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        return (pricePlus - 2 * priceCenter + priceMinus) / (epsilon * epsilon);
+    GreekEstimator MonteCarlo::getGreekEstimator() const {
+        return greekEstimator;
     }
 
-    double MonteCarlo::calculateVega(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.01;
-        double pricePlus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility) + epsilon, option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility) - epsilon, option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        return (pricePlus - priceMinus) / (2 * epsilon);
+    void MonteCarlo::setGreekEstimator(GreekEstimator estimator) {
+        greekEstimator = estimator;
     }
 
-    double MonteCarlo::calculateTheta(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 1.0 / 365;
-        double priceNow = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        double priceLater = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate), asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry() - epsilon, static_cast<int>(std::pow(10, 7)));
-        return (priceLater - priceNow) / epsilon;
+    Valuation MonteCarlo::pathwiseWrapper(const Option& option, const MarketSnapshot& market, const VolSurface* surface,
+                                          std::uint64_t numSimulations) const {
+        double S = market.spotPrice;
+        double r = market.get(Param::riskFreeRate);
+        double sigma = optionVolatility(option, market, surface);
+        double K = option.getStrikePrice();
+        double T = option.getTimeToExpiry();
+        double phi = (option.getType() == OptionType::Call) ? 1.0 : -1.0;
+
+        double sqrtT = std::sqrt(T);
+        double drift = (r - 0.5 * sigma * sigma) * T;
+        double diffusion = sigma * sqrtT;
+
+        // Per path, with ST = S exp(drift + sigma sqrt(T) Z) and payoff max(phi (ST - K), 0):
+        //   dST/dS = ST / S,  dST/dsigma = ST (sqrt(T) Z - sigma T),  dST/dT = ST (r - sigma^2/2 + sigma Z / (2 sqrt(T)))
+        // Gamma has no pathwise estimator (the payoff's derivative jumps at K), so it uses the
+        // likelihood-ratio weight of the pathwise Delta: ST / S^2 (Z / (sigma sqrt(T)) - 1).
+        const std::uint64_t pathsPerSample = settings.antithetic ? 2 : 1;
+        const std::uint64_t numSamples = (numSimulations + pathsPerSample - 1) / pathsPerSample;
+        enum { Price, Delta, Gamma, Vega, DThetaDT, Rho, Count };
+        auto sums = detail::accumulatePaths<Count>(context, 0, numSamples, {}, eachPath(DrawSource{settings.sampling, seed, 0}, [&](double draw, std::array<double, Count>& acc) {
+            for (std::uint64_t k = 0; k < pathsPerSample; ++k) {
+                double Z = detail::drawSigns[k] * draw;
+                double ST = S * std::exp(drift + diffusion * Z);
+                double payoff = std::max(phi * (ST - K), 0.0);
+                if (payoff <= 0.0) {
+                    continue;
+                }
+                acc[Price] += payoff;
+                acc[Delta] += phi * ST / S;
+                acc[Gamma] += phi * ST / (S * S) * (Z / (sigma * sqrtT) - 1.0);
+                acc[Vega] += phi * ST * (sqrtT * Z - sigma * T);
+                acc[DThetaDT] += phi * ST * (r - 0.5 * sigma * sigma + 0.5 * sigma * Z / sqrtT) - r * payoff;
+                acc[Rho] += phi * ST * T - T * payoff;
+            }
+        }));
+
+        double scale = std::exp(-r * T) / static_cast<double>(numSamples * pathsPerSample);
+        Valuation valuation;
+        valuation.price = scale * sums[Price];
+        valuation.greeks.delta = scale * sums[Delta];
+        valuation.greeks.gamma = scale * sums[Gamma];
+        valuation.greeks.vega = scale * sums[Vega];
+        valuation.greeks.theta = -scale * sums[DThetaDT];
+        valuation.greeks.rho = scale * sums[Rho];
+        return valuation;
     }
 
-    double MonteCarlo::calculateRho(const Option& option) {
-        auto asset = option.getAsset();
-        double epsilon = 0.0001;
-        double pricePlus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate) + epsilon, asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        double priceMinus = priceWrapper(option, asset->getSpotPrice(), asset->get(Param::riskFreeRate) - epsilon, asset->get(Param::volatility), option.getStrikePrice(), option.getTimeToExpiry(), static_cast<int>(std::pow(10, 7)));
-        return (pricePlus - priceMinus) / (2 * epsilon);
+    Valuation MonteCarlo::commonRandomNumbersWrapper(const Option& option, const MarketSnapshot& market, const VolSurface* surface,
+                                                     std::uint64_t numSimulations) const {
+        double S = market.spotPrice;
+        double r = market.get(Param::riskFreeRate);
+        double sigma = optionVolatility(option, market, surface);
+        double K = option.getStrikePrice();
+        double T = option.getTimeToExpiry();
+        double phi = (option.getType() == OptionType::Call) ? 1.0 : -1.0;
+
+        // Same bump sizes as the finite-difference Greeks of the other numerical models, but every
+        // bumped scenario is revalued on the same draw, so the noise largely cancels in the differences
+        const double dS = 0.01 * S, dSigma = 0.01, dR = 0.0001, dT = 1.0 / 365;
+        struct Scenario { double spot, rate, vol, expiry; };
+        enum { Base, SpotUp, SpotDown, VolUp, VolDown, RateUp, RateDown, Later, Count };
+        const Scenario scenarios[Count] = {
+            {S, r, sigma, T}, {S + dS, r, sigma, T}, {S - dS, r, sigma, T}, {S, r, sigma + dSigma, T},
+            {S, r, sigma - dSigma, T}, {S, r + dR, sigma, T}, {S, r - dR, sigma, T}, {S, r, sigma, T - dT}
+        };
+
+        double drifts[Count], diffusions[Count], discounts[Count];
+        for (int k = 0; k < Count; ++k) {
+            const Scenario& sc = scenarios[k];
+            drifts[k] = (sc.rate - 0.5 * sc.vol * sc.vol) * sc.expiry;
+            diffusions[k] = sc.vol * std::sqrt(sc.expiry);
+            discounts[k] = std::exp(-sc.rate * sc.expiry);
+        }
+
+        const std::uint64_t pathsPerSample = settings.antithetic ? 2 : 1;
+        const std::uint64_t numSamples = (numSimulations + pathsPerSample - 1) / pathsPerSample;
+        auto sums = detail::accumulatePaths<Count>(context, 0, numSamples, {}, eachPath(DrawSource{settings.sampling, seed, 0}, [&](double draw, std::array<double, Count>& acc) {
+            for (std::uint64_t j = 0; j < pathsPerSample; ++j) {
+                double Z = detail::drawSigns[j] * draw;
+                for (int k = 0; k < Count; ++k) {
+                    double ST = scenarios[k].spot * std::exp(drifts[k] + diffusions[k] * Z);
+                    acc[k] += std::max(phi * (ST - K), 0.0);
+                }
+            }
+        }));
+
+        double prices[Count];
+        for (int k = 0; k < Count; ++k) {
+            prices[k] = discounts[k] * sums[k] / static_cast<double>(numSamples * pathsPerSample);
+        }
+
+        Valuation valuation;
+        valuation.price = prices[Base];
+        valuation.greeks.delta = (prices[SpotUp] - prices[SpotDown]) / (2 * dS);
+        valuation.greeks.gamma = (prices[SpotUp] - 2 * prices[Base] + prices[SpotDown]) / (dS * dS);
+        valuation.greeks.vega = (prices[VolUp] - prices[VolDown]) / (2 * dSigma);
+        valuation.greeks.theta = (prices[Later] - prices[Base]) / dT;
+        valuation.greeks.rho = (prices[RateUp] - prices[RateDown]) / (2 * dR);
+        return valuation;
+    }
+
+    Valuation MonteCarlo::pathDependentWrapper(const Option& option, const MarketSnapshot& market, const VolSurface* surface,
+                                               std::uint64_t numSimulations) const {
+        double S = market.spotPrice;
+        double r = market.get(Param::riskFreeRate);
+        double sigma = optionVolatility(option, market, surface);
+        double K = option.getStrikePrice();
+        double T = option.getTimeToExpiry();
+
+        // Pathwise derivatives of a path payoff are payoff-specific, so every payoff is bumped and
+        // revalued instead. Step k of path p always uses the same draw, so the bumped runs see
+        // the same paths and their noise cancels in the differences.
+        const double dS = 0.01 * S, dSigma = 0.01, dR = 0.0001, dT = 1.0 / 365;
+        auto reprice = [&](double spot, double rate, double vol, double expiry) {
+            return priceWrapper(option, spot, rate, vol, K, expiry, numSimulations, Checkpoint{}).price();
+        };
+
+        const double base = reprice(S, r, sigma, T);
+        const double spotUp = reprice(S + dS, r, sigma, T);
+        const double spotDown = reprice(S - dS, r, sigma, T);
+
+        Valuation valuation;
+        valuation.price = base;
+        valuation.greeks.delta = (spotUp - spotDown) / (2 * dS);
+        valuation.greeks.gamma = (spotUp - 2 * base + spotDown) / (dS * dS);
+        valuation.greeks.vega = (reprice(S, r, sigma + dSigma, T) - reprice(S, r, sigma - dSigma, T)) / (2 * dSigma);
+        valuation.greeks.theta = (reprice(S, r, sigma, T - dT) - base) / dT;
+        valuation.greeks.rho = (reprice(S, r + dR, sigma, T) - reprice(S, r - dR, sigma, T)) / (2 * dR);
+        return valuation;
     }
 
     double MonteCarlo::VaR(const Option& option, double confidenceLevel, double holdingPeriod) const {
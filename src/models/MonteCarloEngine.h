@@ -0,0 +1,145 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef OPTIONLIB_MODELS_MONTECARLOENGINE_H
+#define OPTIONLIB_MODELS_MONTECARLOENGINE_H
+
+// Path bookkeeping shared by the Monte Carlo models: block-ordered reductions, the running
+// sample sums of a Checkpoint and the batched stopping loop behind estimate().
+
+#include <OptionLib/models/MonteCarlo.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace OptionLib::Models::detail {
+
+    // Draw signs for the paths of one sample: Z alone, or Z and its antithetic mirror -Z
+    inline constexpr double drawSigns[2] = {1.0, -1.0};
+
+    // Paths are generated and evaluated this many at a time, in stack buffers
+    inline constexpr std::size_t ChunkSize = 512;
+
+    // Runs perRange(pathBegin, pathEnd, sums) over paths [firstPath, firstPath + numPaths), adding
+    // onto `total`. Paths are grouped into blocks aligned to multiples of PathBlockSize; each
+    // block is summed in path order and block sums are added in block order, so the totals
+    // depend only on the draws and the path range, never on the thread count.
+    template <std::size_t N, typename PerRange>
+    std::array<double, N> accumulatePaths(const ExecutionContext& context, std::uint64_t firstPath,
+                                          std::uint64_t numPaths, std::array<double, N> total, PerRange perRange) {
+        if (numPaths == 0) {
+            return total;
+        }
+        constexpr std::uint64_t B = MonteCarlo::PathBlockSize;
+        const std::uint64_t endPath = firstPath + numPaths;
+        const std::uint64_t firstBlock = firstPath / B;
+        const std::size_t numBlocks = static_cast<std::size_t>((endPath - 1) / B - firstBlock + 1);
+
+        std::vector<std::array<double, N>> blockSums(numBlocks, std::array<double, N>{});
+        context.parallelFor(0, numBlocks, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t block = begin; block < end; ++block) {
+                std::uint64_t pathBegin = std::max(firstPath, (firstBlock + block) * B);
+                std::uint64_t pathEnd = std::min(endPath, (firstBlock + block + 1) * B);
+                perRange(pathBegin, pathEnd, blockSums[block]);
+            }
+        });
+
+        for (const auto& sums : blockSums) {
+            for (std::size_t k = 0; k < N; ++k) {
+                total[k] += sums[k];
+            }
+        }
+        return total;
+    }
+
+    // Running sums of a Checkpoint, in the order X, XX, Y, YY, XY
+    inline constexpr std::size_t SampleSumCount = 5;
+    using SampleSums = std::array<double, SampleSumCount>;
+
+    inline SampleSums sampleSums(const MonteCarlo::Checkpoint& checkpoint) {
+        return {checkpoint.sumX, checkpoint.sumXX, checkpoint.sumY, checkpoint.sumYY, checkpoint.sumXY};
+    }
+
+    inline void setSampleSums(MonteCarlo::Checkpoint& checkpoint, const SampleSums& sums) {
+        checkpoint.sumX = sums[0];
+        checkpoint.sumXX = sums[1];
+        checkpoint.sumY = sums[2];
+        checkpoint.sumYY = sums[3];
+        checkpoint.sumXY = sums[4];
+    }
+
+    // Adds one sample with payoff x and control y
+    inline void addSample(SampleSums& sums, double x, double y, bool withControl) {
+        sums[0] += x;
+        sums[1] += x * x;
+        if (withControl) {
+            sums[2] += y;
+            sums[3] += y * y;
+            sums[4] += x * y;
+        }
+    }
+
+    // Calls simulate(numPaths, from) for each of numReplicates independent replicates, a batch at
+    // a time, until the target standard error, the deadline or maxPaths is reached. A single
+    // replicate reports its own error; several are combined as i.i.d. prices. Replicates run one
+    // per task on `context` and are combined in replicate order.
+    template <typename Simulate>
+    MonteCarlo::Estimate estimateInBatches(const ExecutionContext& context, const MonteCarlo::Settings& settings,
+                                           std::uint32_t numReplicates, Simulate simulate) {
+        using Checkpoint = MonteCarlo::Checkpoint;
+        using Estimate = MonteCarlo::Estimate;
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t batchPaths = std::max<std::uint64_t>(settings.batchPaths, 1);
+
+        std::vector<Checkpoint> replicates(numReplicates);
+        for (std::uint32_t k = 0; k < numReplicates; ++k) {
+            replicates[k].replicate = k;
+        }
+
+        auto combine = [&]() {
+            if (numReplicates == 1) {
+                return Estimate{replicates[0].price(), replicates[0].standardError(), replicates[0].numPaths()};
+            }
+            Estimate combined;
+            double sumSquares = 0.0;
+            for (const Checkpoint& replicate : replicates) {
+                double price = replicate.price();
+                combined.price += price;
+                sumSquares += price * price;
+                combined.numPaths += replicate.numPaths();
+            }
+            double n = static_cast<double>(numReplicates);
+            combined.price /= n;
+            combined.standardError = std::sqrt(std::max(sumSquares / n - combined.price * combined.price, 0.0) / (n - 1.0));
+            return combined;
+        };
+
+        Estimate result = combine();
+        while (result.numPaths < settings.maxPaths) {
+            if (result.numPaths > 0) {
+                if (settings.targetStandardError > 0.0 && result.standardError <= settings.targetStandardError) {
+                    break;
+                }
+                if (settings.deadline.count() > 0 && std::chrono::steady_clock::now() - start >= settings.deadline) {
+                    break;
+                }
+            }
+            std::uint64_t numPaths = std::min(batchPaths, settings.maxPaths - result.numPaths);
+            std::uint64_t perReplicate = std::max<std::uint64_t>(numPaths / numReplicates, 1);
+            context.parallelFor(0, replicates.size(), 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t k = begin; k < end; ++k) {
+                    replicates[k] = simulate(perReplicate, replicates[k]);
+                }
+            });
+            result = combine();
+        }
+        return result;
+    }
+
+} // namespace OptionLib::Models::detail
+
+#endif //OPTIONLIB_MODELS_MONTECARLOENGINE_H
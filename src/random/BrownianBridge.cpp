@@ -0,0 +1,98 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/random/BrownianBridge.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace OptionLib::Random {
+
+    namespace {
+
+        std::vector<double> uniformGrid(std::size_t numSteps, double maturity) {
+            std::vector<double> times(numSteps);
+            for (std::size_t i = 0; i < numSteps; ++i) {
+                times[i] = maturity * static_cast<double>(i + 1) / static_cast<double>(numSteps);
+            }
+            return times;
+        }
+
+    } // namespace
+
+    BrownianBridge::BrownianBridge(std::vector<double> times)
+        : grid(std::move(times)) {
+        const std::size_t n = grid.size();
+        if (n == 0) {
+            throw std::invalid_argument("BrownianBridge: the time grid is empty");
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (grid[i] <= (i == 0 ? 0.0 : grid[i - 1])) {
+                throw std::invalid_argument("BrownianBridge: times must be positive and increasing");
+            }
+        }
+
+        bridgeIndex.resize(n);
+        leftIndex.resize(n);
+        rightIndex.resize(n);
+        leftWeight.resize(n);
+        rightWeight.resize(n);
+        stdDev.resize(n);
+
+        // Jaeckel's construction: each step fills the middle of the next run of unset points
+        std::vector<bool> filled(n, false);
+        bridgeIndex[0] = n - 1;
+        stdDev[0] = std::sqrt(grid[n - 1]);
+        filled[n - 1] = true;
+
+        std::size_t j = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            while (filled[j]) {
+                ++j;
+            }
+            std::size_t k = j;
+            while (!filled[k]) {
+                ++k;
+            }
+            std::size_t l = j + ((k - 1 - j) >> 1);
+            filled[l] = true;
+
+            double tLeft = (j == 0) ? 0.0 : grid[j - 1];
+            double tRight = grid[k];
+            double tMid = grid[l];
+            bridgeIndex[i] = l;
+            leftIndex[i] = j;
+            rightIndex[i] = k;
+            leftWeight[i] = (tRight - tMid) / (tRight - tLeft);
+            rightWeight[i] = (tMid - tLeft) / (tRight - tLeft);
+            stdDev[i] = std::sqrt((tMid - tLeft) * (tRight - tMid) / (tRight - tLeft));
+
+            j = k + 1;
+            if (j >= n) {
+                j = 0;
+            }
+        }
+    }
+
+    BrownianBridge::BrownianBridge(std::size_t numSteps, double maturity)
+        : BrownianBridge(uniformGrid(numSteps, maturity)) {}
+
+    std::size_t BrownianBridge::size() const {
+        return grid.size();
+    }
+
+    const std::vector<double>& BrownianBridge::times() const {
+        return grid;
+    }
+
+    void BrownianBridge::build(const double* normals, double* path) const {
+        const std::size_t n = grid.size();
+        path[n - 1] = stdDev[0] * normals[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            std::size_t j = leftIndex[i];
+            double left = (j == 0) ? 0.0 : path[j - 1];
+            path[bridgeIndex[i]] = leftWeight[i] * left + rightWeight[i] * path[rightIndex[i]] + stdDev[i] * normals[i];
+        }
+    }
+
+} // namespace OptionLib::Random
@@ -0,0 +1,130 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <OptionLib/random/Sobol.h>
+#include <OptionLib/random/Philox.h>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace OptionLib::Random {
+
+    namespace {
+
+        // Dimensions 2..MaxDimensions of new-joe-kuo-6.21201: degree s of the primitive
+        // polynomial, its interior coefficients a, and the initial direction numbers m_1..m_s
+        struct DirectionEntry {
+            unsigned degree;
+            std::uint32_t coefficients;
+            std::uint32_t initial[8];
+        };
+
+        constexpr DirectionEntry directionTable[Sobol::MaxDimensions - 1] = {
+            {1, 0, {1}},
+            {2, 1, {1, 3}},
+            {3, 1, {1, 3, 1}},
+            {3, 2, {1, 1, 1}},
+            {4, 1, {1, 1, 3, 3}},
+            {4, 4, {1, 3, 5, 13}},
+            {5, 2, {1, 1, 5, 5, 17}},
+            {5, 4, {1, 1, 5, 5, 5}},
+            {5, 7, {1, 1, 7, 11, 19}},
+            {5, 11, {1, 1, 5, 1, 1}},
+            {5, 13, {1, 1, 1, 3, 11}},
+            {5, 14, {1, 3, 5, 5, 31}},
+            {6, 1, {1, 3, 3, 9, 7, 49}},
+            {6, 13, {1, 1, 1, 15, 21, 21}},
+            {6, 16, {1, 3, 1, 13, 27, 49}},
+            {6, 19, {1, 1, 1, 15, 7, 5}},
+            {6, 22, {1, 3, 1, 15, 13, 25}},
+            {6, 25, {1, 1, 5, 5, 19, 61}},
+            {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+            {7, 4, {1, 3, 7, 13, 13, 15, 69}},
+        };
+
+        constexpr unsigned Bits = 32;
+
+    } // namespace
+
+    Sobol::Sobol(unsigned dimensions)
+        : numDimensions(dimensions), directions(dimensions * Bits), state(dimensions, 0), shift(dimensions, 0) {
+        if (dimensions == 0 || dimensions > MaxDimensions) {
+            throw std::invalid_argument("Sobol: dimensions must be between 1 and " + std::to_string(MaxDimensions));
+        }
+
+        // First dimension is van der Corput in base 2
+        for (unsigned k = 0; k < Bits; ++k) {
+            directions[k] = 1u << (Bits - 1 - k);
+        }
+
+        // v_k = v_{k-s} ^ (v_{k-s} >> s) ^ sum_j a_j v_{k-j} (Bratley & Fox)
+        for (unsigned dim = 1; dim < dimensions; ++dim) {
+            const DirectionEntry& entry = directionTable[dim - 1];
+            const unsigned s = entry.degree;
+            std::uint32_t* v = &directions[dim * Bits];
+            for (unsigned k = 0; k < s; ++k) {
+                v[k] = entry.initial[k] << (Bits - 1 - k);
+            }
+            for (unsigned k = s; k < Bits; ++k) {
+                v[k] = v[k - s] ^ (v[k - s] >> s);
+                for (unsigned j = 1; j < s; ++j) {
+                    if ((entry.coefficients >> (s - 1 - j)) & 1u) {
+                        v[k] ^= v[k - j];
+                    }
+                }
+            }
+        }
+    }
+
+    Sobol::Sobol(unsigned dimensions, std::uint64_t scrambleSeed)
+        : Sobol(dimensions) {
+        const auto key = Philox4x32::makeKey(scrambleSeed);
+        for (unsigned dim = 0; dim < dimensions; ++dim) {
+            shift[dim] = Philox4x32::generate({dim, 0x5AB0u, 0, 0}, key)[0];
+        }
+        skipTo(0);
+    }
+
+    unsigned Sobol::dimensions() const {
+        return numDimensions;
+    }
+
+    std::uint64_t Sobol::index() const {
+        return current;
+    }
+
+    void Sobol::skipTo(std::uint64_t n) {
+        if (n >> Bits) {
+            throw std::out_of_range("Sobol: point index exceeds 2^32");
+        }
+        // Point n in Gray-code order combines the direction numbers of the set bits of n ^ (n >> 1)
+        const std::uint64_t gray = n ^ (n >> 1);
+        for (unsigned dim = 0; dim < numDimensions; ++dim) {
+            std::uint32_t x = shift[dim];
+            for (unsigned k = 0; k < Bits; ++k) {
+                if ((gray >> k) & 1u) {
+                    x ^= directions[dim * Bits + k];
+                }
+            }
+            state[dim] = x;
+        }
+        current = n;
+    }
+
+    void Sobol::next(double* point) {
+        // Centre of the 2^-32 cell, so no coordinate is ever exactly 0 or 1
+        for (unsigned dim = 0; dim < numDimensions; ++dim) {
+            point[dim] = (static_cast<double>(state[dim]) + 0.5) * 0x1.0p-32;
+        }
+        // Successive Gray codes differ in the lowest set bit of n + 1
+        ++current;
+        const unsigned bit = static_cast<unsigned>(std::countr_zero(current));
+        if (bit < Bits) {
+            for (unsigned dim = 0; dim < numDimensions; ++dim) {
+                state[dim] ^= directions[dim * Bits + bit];
+            }
+        }
+    }
+
+} // namespace OptionLib::Random
@@ -0,0 +1,66 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include "Kernels.h"
+#include <algorithm>
+#include <atomic>
+
+namespace OptionLib {
+
+    namespace {
+
+        SimdLevel probeSimdLevel() {
+#if defined(OPTIONLIB_HAVE_AVX512_KERNELS) || defined(OPTIONLIB_HAVE_AVX2_KERNELS)
+            __builtin_cpu_init();
+#endif
+#ifdef OPTIONLIB_HAVE_AVX512_KERNELS
+            if (__builtin_cpu_supports("avx512f")) {
+                return SimdLevel::AVX512;
+            }
+#endif
+#ifdef OPTIONLIB_HAVE_AVX2_KERNELS
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return SimdLevel::AVX2;
+            }
+#endif
+            return SimdLevel::Scalar;
+        }
+
+        std::atomic<SimdLevel>& activeLevel() {
+            static std::atomic<SimdLevel> level{detectedSimdLevel()};
+            return level;
+        }
+
+    } // namespace
+
+    SimdLevel detectedSimdLevel() {
+        static const SimdLevel detected = probeSimdLevel();
+        return detected;
+    }
+
+    SimdLevel activeSimdLevel() {
+        return activeLevel().load(std::memory_order_relaxed);
+    }
+
+    void setSimdLevel(SimdLevel level) {
+        activeLevel().store(std::min(level, detectedSimdLevel()), std::memory_order_relaxed);
+    }
+
+    namespace Simd {
+
+        const KernelTable& kernels() {
+            switch (activeSimdLevel()) {
+#ifdef OPTIONLIB_HAVE_AVX512_KERNELS
+                case SimdLevel::AVX512: return avx512Kernels();
+#endif
+#ifdef OPTIONLIB_HAVE_AVX2_KERNELS
+                case SimdLevel::AVX2: return avx2Kernels();
+#endif
+                default: return scalarKernels();
+            }
+        }
+
+    } // namespace Simd
+
+} // namespace OptionLib
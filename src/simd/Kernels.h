@@ -0,0 +1,116 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef OPTIONLIB_SIMD_KERNELS_H
+#define OPTIONLIB_SIMD_KERNELS_H
+
+#include <OptionLib/Option.h>
+#include <OptionLib/Simd.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace OptionLib::Simd {
+
+    // Raw pointers for one Black-Scholes batch; output pointers may be null to skip that result
+    struct BlackScholesBatchArgs {
+        const double* spot;
+        const double* strike;
+        const double* expiry;
+        const double* volatility;
+        const double* riskFreeRate;
+        const OptionType* type;
+        double* price;
+        double* delta;
+        double* gamma;
+        double* vega;
+        double* theta;
+        double* rho;
+        std::size_t count;
+    };
+
+    // Draws 2 * pair and 2 * pair + 1 of paths firstPath, ..., firstPath + count - 1, exactly as
+    // Random::NormalStream defines them: one Philox4x32 block per pair, turned into normals by
+    // Box-Muller. `sine` (the second draw) may be null.
+    struct PhiloxNormalArgs {
+        std::uint32_t key[2];
+        std::uint64_t firstPath;
+        std::uint64_t pair;
+        std::size_t count;
+        double* cosine;
+        double* sine;
+    };
+
+    // Terminal spot S exp(drift + diffusion Z) of each normal, its vanilla payoff and, if
+    // `terminal` is non-null, the terminal spot itself. An antithetic sample averages the
+    // values from Z and -Z.
+    struct TerminalPayoffArgs {
+        const double* normals;
+        std::size_t count;
+        double spot;
+        double drift;
+        double diffusion;
+        double strike;
+        OptionType type;
+        bool antithetic;
+        double* payoff;
+        double* terminal;
+    };
+
+    // to[i] = from[i] exp(drift + diffusion normals[i]): one time step of geometric Brownian motion
+    struct GeometricStepArgs {
+        const double* normals;
+        const double* from;
+        double* to;
+        std::size_t count;
+        double drift;
+        double diffusion;
+    };
+
+    // Per-contract outcome of impliedVolatilityBatch, written to `status` as a double
+    enum class ImpliedVolatilityCode : std::uint8_t {
+        Converged,
+        NotConverged,
+        BelowIntrinsic,
+        AboveMaximum
+    };
+
+    // Black-Scholes implied volatilities of `count` prices; phi is +1 for calls and -1 for puts.
+    // status receives ImpliedVolatilityCode values and iterations the Householder steps taken,
+    // both as doubles.
+    struct ImpliedVolatilityBatchArgs {
+        const double* price;
+        const double* spot;
+        const double* strike;
+        const double* expiry;
+        const double* riskFreeRate;
+        const double* phi;
+        double* volatility;
+        double* status;
+        double* iterations;
+        std::size_t count;
+    };
+
+    // One entry per kernel, filled in by each instruction-set translation unit
+    struct KernelTable {
+        void (*blackScholesBatch)(const BlackScholesBatchArgs& args);
+        void (*philoxNormals)(const PhiloxNormalArgs& args);
+        void (*terminalPayoff)(const TerminalPayoffArgs& args);
+        void (*geometricStep)(const GeometricStepArgs& args);
+        void (*impliedVolatilityBatch)(const ImpliedVolatilityBatchArgs& args);
+    };
+
+    const KernelTable& scalarKernels();
+#ifdef OPTIONLIB_HAVE_AVX2_KERNELS
+    const KernelTable& avx2Kernels();
+#endif
+#ifdef OPTIONLIB_HAVE_AVX512_KERNELS
+    const KernelTable& avx512Kernels();
+#endif
+
+    // Kernels for the active SimdLevel
+    const KernelTable& kernels();
+
+} // namespace OptionLib::Simd
+
+#endif //OPTIONLIB_SIMD_KERNELS_H
@@ -0,0 +1,423 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef OPTIONLIB_SIMD_KERNELSIMPL_H
+#define OPTIONLIB_SIMD_KERNELSIMPL_H
+
+// Kernel bodies shared by the per-instruction-set translation units. Everything here has
+// internal linkage so that code compiled with wider instruction sets is never merged into
+// the scalar fallback by the linker.
+
+#include "Kernels.h"
+#include "VecMath.h"
+#include <limits>
+
+namespace OptionLib::Simd {
+namespace {
+
+    // Prices (and optionally Greeks) for V::width contiguous lanes starting at index i
+    template <class V>
+    void blackScholesLanes(const BlackScholesBatchArgs& args, std::size_t i, const double* phiLanes) {
+        using R = typename V::Reg;
+        R S = V::load(args.spot + i);
+        R K = V::load(args.strike + i);
+        R T = V::load(args.expiry + i);
+        R sigma = V::load(args.volatility + i);
+        R r = V::load(args.riskFreeRate + i);
+        R phi = V::load(phiLanes);  // +1 for calls, -1 for puts
+
+        R sqrtT = V::sqrt(T);
+        R sigmaSqrtT = V::mul(sigma, sqrtT);
+        R drift = V::fma(V::mul(V::broadcast(0.5), sigma), sigma, r);
+        R d1 = V::div(V::fma(drift, T, log<V>(V::div(S, K))), sigmaSqrtT);
+        R d2 = V::sub(d1, sigmaSqrtT);
+        R discountedK = V::mul(K, exp<V>(V::sub(V::broadcast(0.0), V::mul(r, T))));
+
+        // With phi = +/-1 the call and put formulas coincide, e.g. price = phi (S N(phi d1) - K e^{-rT} N(phi d2))
+        R nd1 = normalCdf<V>(V::mul(phi, d1));
+        R nd2 = normalCdf<V>(V::mul(phi, d2));
+
+        if (args.price) {
+            V::store(args.price + i, V::mul(phi, V::fnma(discountedK, nd2, V::mul(S, nd1))));
+        }
+        if (args.delta) {
+            V::store(args.delta + i, V::mul(phi, nd1));
+        }
+        if (args.gamma || args.vega || args.theta) {
+            R pdf = normalPdf<V>(d1);
+            if (args.gamma) {
+                V::store(args.gamma + i, V::div(pdf, V::mul(S, sigmaSqrtT)));
+            }
+            if (args.vega) {
+                V::store(args.vega + i, V::mul(V::mul(S, pdf), sqrtT));
+            }
+            if (args.theta) {
+                R decay = V::div(V::mul(V::mul(S, pdf), sigma), V::mul(V::broadcast(2.0), sqrtT));
+                R carry = V::mul(V::mul(phi, r), V::mul(discountedK, nd2));
+                V::store(args.theta + i, V::sub(V::sub(V::broadcast(0.0), decay), carry));
+            }
+        }
+        if (args.rho) {
+            V::store(args.rho + i, V::mul(V::mul(phi, T), V::mul(discountedK, nd2)));
+        }
+    }
+
+    template <class V>
+    void blackScholesBatch(const BlackScholesBatchArgs& args) {
+        constexpr std::size_t W = V::width;
+        alignas(64) double phi[W];
+
+        std::size_t i = 0;
+        for (; i + W <= args.count; i += W) {
+            for (std::size_t l = 0; l < W; ++l) {
+                phi[l] = (args.type[i + l] == OptionType::Call) ? 1.0 : -1.0;
+            }
+            blackScholesLanes<V>(args, i, phi);
+        }
+        if (i == args.count) {
+            return;
+        }
+
+        // Remainder: run one padded block on local copies and keep only the valid lanes
+        std::size_t valid = args.count - i;
+        alignas(64) double in[5][W];
+        alignas(64) double out[6][W];
+        const double* sources[5] = {args.spot, args.strike, args.expiry, args.volatility, args.riskFreeRate};
+        for (std::size_t l = 0; l < W; ++l) {
+            bool live = l < valid;
+            for (int k = 0; k < 5; ++k) {
+                in[k][l] = live ? sources[k][i + l] : (k == 4 ? 0.0 : 1.0);
+            }
+            phi[l] = (live && args.type[i + l] == OptionType::Put) ? -1.0 : 1.0;
+        }
+
+        double* targets[6] = {args.price, args.delta, args.gamma, args.vega, args.theta, args.rho};
+        BlackScholesBatchArgs tail{in[0], in[1], in[2], in[3], in[4], nullptr,
+                                   targets[0] ? out[0] : nullptr, targets[1] ? out[1] : nullptr,
+                                   targets[2] ? out[2] : nullptr, targets[3] ? out[3] : nullptr,
+                                   targets[4] ? out[4] : nullptr, targets[5] ? out[5] : nullptr, W};
+        blackScholesLanes<V>(tail, 0, phi);
+
+        for (int k = 0; k < 6; ++k) {
+            if (targets[k]) {
+                for (std::size_t l = 0; l < valid; ++l) {
+                    targets[k][i + l] = out[k][l];
+                }
+            }
+        }
+    }
+
+    // Runs lanes(in, out) over `count` values in blocks of V::width. The remainder runs as one
+    // block on padded local copies, so every lane sees the same instruction sequence.
+    template <class V, std::size_t In, std::size_t Out, typename Lanes>
+    void forEachBlock(std::size_t count, const double* const (&in)[In], double* const (&out)[Out],
+                      const double (&padding)[In], Lanes lanes) {
+        constexpr std::size_t W = V::width;
+        std::size_t i = 0;
+        for (; i + W <= count; i += W) {
+            const double* blockIn[In];
+            double* blockOut[Out];
+            for (std::size_t k = 0; k < In; ++k) {
+                blockIn[k] = in[k] + i;
+            }
+            for (std::size_t k = 0; k < Out; ++k) {
+                blockOut[k] = out[k] ? out[k] + i : nullptr;
+            }
+            lanes(blockIn, blockOut);
+        }
+        if (i == count) {
+            return;
+        }
+
+        const std::size_t valid = count - i;
+        alignas(64) double padded[In][W];
+        alignas(64) double results[Out][W];
+        const double* blockIn[In];
+        double* blockOut[Out];
+        for (std::size_t k = 0; k < In; ++k) {
+            for (std::size_t l = 0; l < W; ++l) {
+                padded[k][l] = l < valid ? in[k][i + l] : padding[k];
+            }
+            blockIn[k] = padded[k];
+        }
+        for (std::size_t k = 0; k < Out; ++k) {
+            blockOut[k] = out[k] ? results[k] : nullptr;
+        }
+        lanes(blockIn, blockOut);
+        for (std::size_t k = 0; k < Out; ++k) {
+            if (out[k]) {
+                for (std::size_t l = 0; l < valid; ++l) {
+                    out[k][i + l] = results[k][l];
+                }
+            }
+        }
+    }
+
+    template <class V>
+    void philoxNormalLanes(const PhiloxNormalArgs& args, std::uint64_t firstPath, double* cosine, double* sine) {
+        using B = typename V::Bits;
+        using R = typename V::Reg;
+        const B low32 = V::broadcastBits(0xFFFFFFFFull);
+        const B m0 = V::broadcastBits(0xD2511F53ull);
+        const B m1 = V::broadcastBits(0xCD9E8D57ull);
+
+        // Counter {path low, path high, pair low, pair high}, one 32-bit word per 64-bit lane
+        B path = V::iota(firstPath);
+        B c0 = V::and64(path, low32);
+        B c1 = V::template shr64<32>(path);
+        B c2 = V::broadcastBits(args.pair & 0xFFFFFFFFull);
+        B c3 = V::broadcastBits(args.pair >> 32);
+        std::uint32_t k0 = args.key[0], k1 = args.key[1];
+
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            B product0 = V::mulLow32(m0, c0);
+            B product1 = V::mulLow32(m1, c2);
+            c0 = V::xor64(V::xor64(V::template shr64<32>(product1), c1), V::broadcastBits(k0));
+            c1 = V::and64(product1, low32);
+            c2 = V::xor64(V::xor64(V::template shr64<32>(product0), c3), V::broadcastBits(k1));
+            c3 = V::and64(product0, low32);
+        }
+
+        // 53-bit uniforms on (0, 1), as Philox4x32::toUniform: ((hi << 32 | lo) >> 11 + 1/2) 2^-53
+        auto uniform = [](B hi, B lo) {
+            R high = V::mul(V::toDouble(hi), V::broadcast(0x1.0p21));
+            R bits = V::add(high, V::toDouble(V::template shr64<11>(lo)));
+            return V::mul(V::add(bits, V::broadcast(0.5)), V::broadcast(0x1.0p-53));
+        };
+        R radius = V::sqrt(V::mul(V::broadcast(-2.0), log<V>(uniform(c0, c1))));
+        R s, c;
+        sinCos2Pi<V>(uniform(c2, c3), s, c);
+        V::store(cosine, V::mul(radius, c));
+        if (sine) {
+            V::store(sine, V::mul(radius, s));
+        }
+    }
+
+    template <class V>
+    void philoxNormals(const PhiloxNormalArgs& args) {
+        constexpr std::size_t W = V::width;
+        std::size_t i = 0;
+        for (; i + W <= args.count; i += W) {
+            philoxNormalLanes<V>(args, args.firstPath + i, args.cosine + i, args.sine ? args.sine + i : nullptr);
+        }
+        if (i == args.count) {
+            return;
+        }
+        alignas(64) double cosine[W], sine[W];
+        philoxNormalLanes<V>(args, args.firstPath + i, cosine, sine);
+        for (std::size_t l = 0; i + l < args.count; ++l) {
+            args.cosine[i + l] = cosine[l];
+            if (args.sine) {
+                args.sine[i + l] = sine[l];
+            }
+        }
+    }
+
+    // The call/put choice is a template parameter, so the path loop itself never branches on it
+    template <class V, bool IsCall>
+    void terminalPayoffLanes(const TerminalPayoffArgs& args) {
+        using R = typename V::Reg;
+        const R S = V::broadcast(args.spot);
+        const R K = V::broadcast(args.strike);
+        const R drift = V::broadcast(args.drift);
+        const R diffusion = V::broadcast(args.diffusion);
+        const R zero = V::broadcast(0.0);
+        const R half = V::broadcast(0.5);
+        const bool antithetic = args.antithetic;
+
+        auto payoff = [&](R ST) {
+            return IsCall ? V::max(V::sub(ST, K), zero) : V::max(V::sub(K, ST), zero);
+        };
+
+        forEachBlock<V>(args.count, {args.normals}, {args.payoff, args.terminal}, {0.0},
+                        [&](const double* const* in, double* const* out) {
+            R Z = V::load(in[0]);
+            R ST = V::mul(S, exp<V>(V::fma(diffusion, Z, drift)));
+            R value = payoff(ST);
+            if (antithetic) {
+                R mirror = V::mul(S, exp<V>(V::fnma(diffusion, Z, drift)));
+                value = V::mul(half, V::add(value, payoff(mirror)));
+                ST = V::mul(half, V::add(ST, mirror));
+            }
+            V::store(out[0], value);
+            if (out[1]) {
+                V::store(out[1], ST);
+            }
+        });
+    }
+
+    template <class V>
+    void terminalPayoff(const TerminalPayoffArgs& args) {
+        if (args.type == OptionType::Call) {
+            terminalPayoffLanes<V, true>(args);
+        } else {
+            terminalPayoffLanes<V, false>(args);
+        }
+    }
+
+    template <class V>
+    void geometricStep(const GeometricStepArgs& args) {
+        using R = typename V::Reg;
+        const R drift = V::broadcast(args.drift);
+        const R diffusion = V::broadcast(args.diffusion);
+        forEachBlock<V>(args.count, {args.normals, args.from}, {args.to}, {0.0, 1.0},
+                        [&](const double* const* in, double* const* out) {
+            V::store(out[0], V::mul(V::load(in[1]), exp<V>(V::fma(diffusion, V::load(in[0]), drift))));
+        });
+    }
+
+    // The inversion works with the normalised call b(x, s) = e^{x/2} N(x/s + s/2) - e^{-x/2} N(x/s - s/2)
+    // on x = ln(F/K) <= 0 and s = sigma sqrt(T): every price is first reduced to an out-of-the-money call
+    // by removing its intrinsic value and using put(x) = call(-x). Below the inflection point
+    // s_c = sqrt(-2x) the objective is 1/ln b - 1/ln beta, which is close to linear in s where b is
+    // exponentially small; above it the objective is b - beta. Both start from Jaeckel's asymptotic
+    // guesses ("Let's be rational", 2015) and take third-order Householder steps.
+    inline constexpr int MaxImpliedVolatilityIterations = 10;
+    inline constexpr double ImpliedVolatilityStepTolerance = 1e-6;   // relative; the next step would be below 1e-15
+
+    template <class V>
+    void impliedVolatilityBatch(const ImpliedVolatilityBatchArgs& args) {
+        using R = typename V::Reg;
+        constexpr std::size_t W = V::width;
+        auto code = [](ImpliedVolatilityCode status) { return V::broadcast(static_cast<double>(status)); };
+        auto flag = [](auto mask) { return V::select(mask, V::broadcast(1.0), V::broadcast(0.0)); };
+        auto isSet = [](R value) { return V::gt(value, V::broadcast(0.5)); };
+
+        const R zero = V::broadcast(0.0);
+        const R one = V::broadcast(1.0);
+        const R half = V::broadcast(0.5);
+        const R quarter = V::broadcast(0.25);
+
+        // Padding lanes hold an at-the-money call on a unit spot, which is always invertible
+        forEachBlock<V>(args.count,
+                        {args.price, args.spot, args.strike, args.expiry, args.riskFreeRate, args.phi},
+                        {args.volatility, args.status, args.iterations},
+                        {0.1, 1.0, 1.0, 1.0, 0.0, 1.0},
+                        [&](const double* const* in, double* const* out) {
+            R S = V::load(in[1]);
+            R K = V::load(in[2]);
+            R T = V::load(in[3]);
+            R rT = V::mul(V::load(in[4]), T);
+            R phi = V::load(in[5]);
+
+            // Normalised price beta = undiscounted price / sqrt(F K), reduced to an out-of-the-money call
+            R x = V::add(log<V>(V::div(S, K)), rT);
+            R beta = V::div(V::mul(V::load(in[0]), exp<V>(V::mul(half, rT))), V::sqrt(V::mul(S, K)));
+            R growth = exp<V>(V::mul(half, x));
+            R intrinsic = V::max(V::mul(phi, V::sub(growth, V::div(one, growth))), zero);
+            beta = V::sub(beta, intrinsic);
+            x = V::sub(zero, V::abs(x));
+            R bMax = V::min(growth, V::div(one, growth));   // e^{x/2}, the price at infinite volatility
+            R bMin = V::div(one, bMax);                      // e^{-x/2}
+
+            // Time values that underflow to subnormals are left as not converged
+            R positive = flag(V::gt(beta, zero));
+            R valid = V::select(V::lt(beta, bMax), flag(V::gt(beta, V::broadcast(std::numeric_limits<double>::min()))), zero);
+            R atIntrinsic = V::select(V::lt(beta, zero), zero, V::select(V::lt(beta, bMax), V::sub(one, positive), zero));
+            R above = V::select(V::lt(beta, bMax), zero, positive);
+
+            // Guesses on either side of the inflection point, where d1 = 0
+            R sc = V::sqrt(V::mul(V::broadcast(-2.0), x));
+            R bc = V::fnma(bMin, normalCdf<V>(V::sub(zero, sc)), V::mul(half, bMax));
+            R lower = flag(V::lt(beta, bc));
+
+            // Lower: beta ~ 2 pi |x| / (3 sqrt 3) N(-|x| / (sqrt 3 s))^3
+            R cube = exp<V>(V::mul(V::broadcast(1.0 / 3.0),
+                                   log<V>(V::div(V::mul(V::broadcast(0.82699334313268807), beta), V::abs(x)))));
+            R z = inverseNormalCdf<V>(V::min(cube, V::broadcast(0.5 - 1e-9)));
+            R sLower = V::min(V::div(x, V::mul(V::broadcast(1.7320508075688772), z)), sc);
+            // Upper: bMax - beta ~ (e^{x/2} + e^{-x/2}) N(-s/2)
+            R tailWeight = V::div(V::sub(bMax, beta), V::add(bMax, bMin));
+            R sUpper = V::max(V::mul(V::broadcast(-2.0), inverseNormalCdf<V>(tailWeight)), sc);
+
+            R s = V::select(isSet(valid), V::select(isSet(lower), sLower, sUpper), one);
+            R lnBeta = log<V>(V::select(isSet(valid), beta, one));
+            R active = valid;
+            R iterations = zero;
+
+            for (int iteration = 0; iteration < MaxImpliedVolatilityIterations; ++iteration) {
+                R h = V::div(x, s);
+                R t = V::mul(half, s);
+                R b = V::fnma(bMin, normalCdf<V>(V::sub(h, t)), V::mul(bMax, normalCdf<V>(V::add(h, t))));
+                R vega = V::mul(V::broadcast(kInvSqrt2Pi), exp<V>(V::mul(V::broadcast(-0.5), V::fma(h, h, V::mul(t, t)))));
+                // b''/b' and b'''/b'
+                R hOverS = V::div(V::mul(h, h), s);
+                R r2 = V::fnma(quarter, s, hOverS);
+                R r3 = V::sub(V::fnma(V::broadcast(3.0), V::div(hOverS, s), V::mul(r2, r2)), quarter);
+
+                // Newton step and the ratios g''/g', g'''/g' of each objective
+                R nuUpper = V::div(V::sub(beta, b), vega);
+                R L = log<V>(b);
+                R L1 = V::div(vega, b);
+                R LRatio = V::div(L1, L);
+                R nuLower = V::mul(V::div(L, L1), V::sub(one, V::div(L, lnBeta)));
+                R r2Lower = V::sub(r2, L1);
+                R h2Lower = V::fnma(V::broadcast(2.0), LRatio, r2Lower);
+                R h3Lower = V::fma(V::broadcast(6.0), V::mul(LRatio, V::sub(LRatio, r2Lower)),
+                                   V::fma(V::mul(V::broadcast(2.0), L1), L1, V::fnma(V::mul(V::broadcast(3.0), L1), r2, r3)));
+
+                auto useLower = isSet(lower);
+                R nu = V::select(useLower, nuLower, nuUpper);
+                R h2 = V::select(useLower, h2Lower, r2);
+                R h3 = V::select(useLower, h3Lower, r3);
+                R step = V::div(V::mul(nu, V::fma(V::mul(half, h2), nu, one)),
+                                V::fma(nu, V::fma(V::mul(V::broadcast(1.0 / 6.0), h3), nu, h2), one));
+                // Keep s positive should a step from a poor guess overshoot
+                R next = V::min(V::max(V::add(s, step), V::mul(quarter, s)), V::mul(V::broadcast(4.0), s));
+
+                s = V::select(isSet(active), next, s);
+                iterations = V::add(iterations, active);
+                active = V::select(V::gt(V::abs(step), V::mul(V::broadcast(ImpliedVolatilityStepTolerance), s)), active, zero);
+
+                alignas(64) double pending[W];
+                V::store(pending, active);
+                bool any = false;
+                for (std::size_t l = 0; l < W; ++l) {
+                    any = any || pending[l] != 0.0;
+                }
+                if (!any) {
+                    break;
+                }
+            }
+
+            // A NaN fails both comparisons and is reported as not converged
+            R finite = flag(V::lt(s, V::broadcast(1e300)));
+            R converged = V::select(isSet(active), zero, V::select(isSet(valid), finite, zero));
+            R status = code(ImpliedVolatilityCode::NotConverged);
+            status = V::select(isSet(converged), code(ImpliedVolatilityCode::Converged), status);
+            status = V::select(V::lt(beta, zero), code(ImpliedVolatilityCode::BelowIntrinsic), status);
+            status = V::select(isSet(above), code(ImpliedVolatilityCode::AboveMaximum), status);
+            status = V::select(isSet(atIntrinsic), code(ImpliedVolatilityCode::Converged), status);
+
+            R volatility = V::select(isSet(converged), V::div(s, V::sqrt(T)), V::broadcast(std::numeric_limits<double>::quiet_NaN()));
+            volatility = V::select(isSet(atIntrinsic), zero, volatility);
+            V::store(out[0], volatility);
+            if (out[1]) {
+                V::store(out[1], status);
+            }
+            if (out[2]) {
+                V::store(out[2], iterations);
+            }
+        });
+    }
+
+    template <class V>
+    KernelTable makeKernelTable() {
+        return KernelTable{
+            &blackScholesBatch<V>,
+            &philoxNormals<V>,
+            &terminalPayoff<V>,
+            &geometricStep<V>,
+            &impliedVolatilityBatch<V>,
+        };
+    }
+
+} // namespace
+} // namespace OptionLib::Simd
+
+#endif //OPTIONLIB_SIMD_KERNELSIMPL_H
@@ -0,0 +1,19 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+// Compiled with -mavx2 -mfma when OPTIONLIB_HAVE_AVX2_KERNELS is defined (see CMakeLists.txt)
+#ifdef OPTIONLIB_HAVE_AVX2_KERNELS
+
+#include "KernelsImpl.h"
+
+namespace OptionLib::Simd {
+
+    const KernelTable& avx2Kernels() {
+        static const KernelTable table = makeKernelTable<Avx2Vec>();
+        return table;
+    }
+
+} // namespace OptionLib::Simd
+
+#endif
@@ -0,0 +1,19 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+// Compiled with -mavx512f when OPTIONLIB_HAVE_AVX512_KERNELS is defined (see CMakeLists.txt)
+#ifdef OPTIONLIB_HAVE_AVX512_KERNELS
+
+#include "KernelsImpl.h"
+
+namespace OptionLib::Simd {
+
+    const KernelTable& avx512Kernels() {
+        static const KernelTable table = makeKernelTable<Avx512Vec>();
+        return table;
+    }
+
+} // namespace OptionLib::Simd
+
+#endif
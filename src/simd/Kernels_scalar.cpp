@@ -0,0 +1,14 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include "KernelsImpl.h"
+
+namespace OptionLib::Simd {
+
+    const KernelTable& scalarKernels() {
+        static const KernelTable table = makeKernelTable<ScalarVec>();
+        return table;
+    }
+
+} // namespace OptionLib::Simd
@@ -0,0 +1,212 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef OPTIONLIB_SIMD_VEC_H
+#define OPTIONLIB_SIMD_VEC_H
+
+// Thin wrappers giving the scalar, AVX2 and AVX-512 registers a common interface, so that the
+// kernels in KernelsImpl.h are written once and instantiated per instruction set. Only the
+// wrappers enabled by the current translation unit's compile flags are defined, and all of them
+// have internal linkage so each instruction set keeps its own copy.
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace OptionLib::Simd {
+namespace {
+
+    struct ScalarVec {
+        using Reg = double;
+        using Mask = bool;
+        static constexpr std::size_t width = 1;
+
+        static Reg load(const double* p) { return *p; }
+        static void store(double* p, Reg a) { *p = a; }
+        static Reg broadcast(double x) { return x; }
+
+        static Reg add(Reg a, Reg b) { return a + b; }
+        static Reg sub(Reg a, Reg b) { return a - b; }
+        static Reg mul(Reg a, Reg b) { return a * b; }
+        static Reg div(Reg a, Reg b) { return a / b; }
+#ifdef FP_FAST_FMA
+        static Reg fma(Reg a, Reg b, Reg c) { return std::fma(a, b, c); }     // a * b + c
+        static Reg fnma(Reg a, Reg b, Reg c) { return std::fma(-a, b, c); }  // c - a * b
+#else
+        // Without hardware FMA std::fma is emulated in software, which is far slower than the rounding it saves
+        static Reg fma(Reg a, Reg b, Reg c) { return a * b + c; }
+        static Reg fnma(Reg a, Reg b, Reg c) { return c - a * b; }
+#endif
+        static Reg sqrt(Reg a) { return std::sqrt(a); }
+        static Reg abs(Reg a) { return std::fabs(a); }
+        static Reg min(Reg a, Reg b) { return a < b ? a : b; }
+        static Reg max(Reg a, Reg b) { return a > b ? a : b; }
+        static Reg round(Reg a) { return std::nearbyint(a); }
+
+        static Mask lt(Reg a, Reg b) { return a < b; }
+        static Mask gt(Reg a, Reg b) { return a > b; }
+        static Reg select(Mask m, Reg a, Reg b) { return m ? a : b; }
+
+        // 2^n for integral-valued n in [-1022, 1023]
+        static Reg pow2n(Reg n) {
+            return std::bit_cast<double>(static_cast<std::uint64_t>(static_cast<std::int64_t>(n) + 1023) << 52);
+        }
+
+        // Split positive, normal x into its unbiased exponent and a mantissa in [1, 2)
+        static void split(Reg x, Reg& exponent, Reg& mantissa) {
+            auto bits = std::bit_cast<std::uint64_t>(x);
+            exponent = static_cast<double>(static_cast<std::int64_t>((bits >> 52) & 0x7FF) - 1023);
+            mantissa = std::bit_cast<double>((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+        }
+
+        // 64-bit integer lanes, used by the counter-based random number kernels
+        using Bits = std::uint64_t;
+        static Bits iota(std::uint64_t start) { return start; }
+        static Bits broadcastBits(std::uint64_t x) { return x; }
+        static Bits add64(Bits a, Bits b) { return a + b; }
+        static Bits xor64(Bits a, Bits b) { return a ^ b; }
+        static Bits and64(Bits a, Bits b) { return a & b; }
+        template <int N> static Bits shr64(Bits a) { return a >> N; }
+        template <int N> static Bits shl64(Bits a) { return a << N; }
+        // Full 64-bit product of the low 32 bits of each lane
+        static Bits mulLow32(Bits a, Bits b) { return (a & 0xFFFFFFFFull) * (b & 0xFFFFFFFFull); }
+        // Exact conversion for x < 2^52
+        static Reg toDouble(Bits x) { return static_cast<double>(x); }
+    };
+
+#if defined(__AVX2__) && defined(__FMA__)
+    struct Avx2Vec {
+        using Reg = __m256d;
+        using Mask = __m256d;
+        static constexpr std::size_t width = 4;
+
+        static Reg load(const double* p) { return _mm256_loadu_pd(p); }
+        static void store(double* p, Reg a) { _mm256_storeu_pd(p, a); }
+        static Reg broadcast(double x) { return _mm256_set1_pd(x); }
+
+        static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+        static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+        static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+        static Reg div(Reg a, Reg b) { return _mm256_div_pd(a, b); }
+        static Reg fma(Reg a, Reg b, Reg c) { return _mm256_fmadd_pd(a, b, c); }
+        static Reg fnma(Reg a, Reg b, Reg c) { return _mm256_fnmadd_pd(a, b, c); }
+        static Reg sqrt(Reg a) { return _mm256_sqrt_pd(a); }
+        static Reg abs(Reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+        static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+        static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+        static Reg round(Reg a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        static Mask lt(Reg a, Reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static Mask gt(Reg a, Reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static Reg select(Mask m, Reg a, Reg b) { return _mm256_blendv_pd(b, a, m); }
+
+        static Reg pow2n(Reg n) {
+            // Adding 1.5 * 2^52 moves the integer into the low mantissa bits
+            __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(6755399441055744.0)));
+            bits = _mm256_add_epi64(bits, _mm256_set1_epi64x(1023));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+        }
+
+        static void split(Reg x, Reg& exponent, Reg& mantissa) {
+            __m256i bits = _mm256_castpd_si256(x);
+            __m256i biased = _mm256_and_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x7FF));
+            // Biased exponent is non-negative, so OR-ing into 2^52 converts it to double exactly
+            Reg asDouble = _mm256_sub_pd(
+                _mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_set1_epi64x(0x4330000000000000ll))),
+                _mm256_set1_pd(4503599627370496.0));
+            exponent = _mm256_sub_pd(asDouble, _mm256_set1_pd(1023.0));
+            mantissa = _mm256_castsi256_pd(_mm256_or_si256(
+                _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+                _mm256_set1_epi64x(0x3FF0000000000000ll)));
+        }
+
+        using Bits = __m256i;
+        static Bits iota(std::uint64_t start) {
+            return _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(start)), _mm256_set_epi64x(3, 2, 1, 0));
+        }
+        static Bits broadcastBits(std::uint64_t x) { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+        static Bits add64(Bits a, Bits b) { return _mm256_add_epi64(a, b); }
+        static Bits xor64(Bits a, Bits b) { return _mm256_xor_si256(a, b); }
+        static Bits and64(Bits a, Bits b) { return _mm256_and_si256(a, b); }
+        template <int N> static Bits shr64(Bits a) { return _mm256_srli_epi64(a, N); }
+        template <int N> static Bits shl64(Bits a) { return _mm256_slli_epi64(a, N); }
+        static Bits mulLow32(Bits a, Bits b) { return _mm256_mul_epu32(a, b); }
+        static Reg toDouble(Bits x) {
+            return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(x, _mm256_set1_epi64x(0x4330000000000000ll))),
+                                 _mm256_set1_pd(4503599627370496.0));
+        }
+    };
+#endif
+
+#if defined(__AVX512F__)
+    struct Avx512Vec {
+        using Reg = __m512d;
+        using Mask = __mmask8;
+        static constexpr std::size_t width = 8;
+
+        static Reg load(const double* p) { return _mm512_loadu_pd(p); }
+        static void store(double* p, Reg a) { _mm512_storeu_pd(p, a); }
+        static Reg broadcast(double x) { return _mm512_set1_pd(x); }
+
+        static Reg add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+        static Reg sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+        static Reg mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+        static Reg div(Reg a, Reg b) { return _mm512_div_pd(a, b); }
+        static Reg fma(Reg a, Reg b, Reg c) { return _mm512_fmadd_pd(a, b, c); }
+        static Reg fnma(Reg a, Reg b, Reg c) { return _mm512_fnmadd_pd(a, b, c); }
+        static Reg sqrt(Reg a) { return _mm512_sqrt_pd(a); }
+        static Reg abs(Reg a) { return _mm512_abs_pd(a); }
+        static Reg min(Reg a, Reg b) { return _mm512_min_pd(a, b); }
+        static Reg max(Reg a, Reg b) { return _mm512_max_pd(a, b); }
+        static Reg round(Reg a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        static Mask lt(Reg a, Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+        static Mask gt(Reg a, Reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+        static Reg select(Mask m, Reg a, Reg b) { return _mm512_mask_blend_pd(m, b, a); }
+
+        static Reg pow2n(Reg n) {
+            __m512i bits = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(6755399441055744.0)));
+            bits = _mm512_add_epi64(bits, _mm512_set1_epi64(1023));
+            return _mm512_castsi512_pd(_mm512_slli_epi64(bits, 52));
+        }
+
+        static void split(Reg x, Reg& exponent, Reg& mantissa) {
+            __m512i bits = _mm512_castpd_si512(x);
+            __m512i biased = _mm512_and_si512(_mm512_srli_epi64(bits, 52), _mm512_set1_epi64(0x7FF));
+            Reg asDouble = _mm512_sub_pd(
+                _mm512_castsi512_pd(_mm512_or_si512(biased, _mm512_set1_epi64(0x4330000000000000ll))),
+                _mm512_set1_pd(4503599627370496.0));
+            exponent = _mm512_sub_pd(asDouble, _mm512_set1_pd(1023.0));
+            mantissa = _mm512_castsi512_pd(_mm512_or_si512(
+                _mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFll)),
+                _mm512_set1_epi64(0x3FF0000000000000ll)));
+        }
+
+        using Bits = __m512i;
+        static Bits iota(std::uint64_t start) {
+            return _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(start)), _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+        }
+        static Bits broadcastBits(std::uint64_t x) { return _mm512_set1_epi64(static_cast<long long>(x)); }
+        static Bits add64(Bits a, Bits b) { return _mm512_add_epi64(a, b); }
+        static Bits xor64(Bits a, Bits b) { return _mm512_xor_si512(a, b); }
+        static Bits and64(Bits a, Bits b) { return _mm512_and_si512(a, b); }
+        template <int N> static Bits shr64(Bits a) { return _mm512_srli_epi64(a, N); }
+        template <int N> static Bits shl64(Bits a) { return _mm512_slli_epi64(a, N); }
+        static Bits mulLow32(Bits a, Bits b) { return _mm512_mul_epu32(a, b); }
+        static Reg toDouble(Bits x) {
+            return _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(x, _mm512_set1_epi64(0x4330000000000000ll))),
+                                 _mm512_set1_pd(4503599627370496.0));
+        }
+    };
+#endif
+
+} // namespace
+} // namespace OptionLib::Simd
+
+#endif //OPTIONLIB_SIMD_VEC_H
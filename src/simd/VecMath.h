@@ -0,0 +1,230 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#ifndef OPTIONLIB_SIMD_VECMATH_H
+#define OPTIONLIB_SIMD_VECMATH_H
+
+// Branch-free elementary functions written against the Vec.h interface. Every lane follows
+// the same sequence of IEEE operations, so the vector instruction sets produce identical
+// results. The scalar fallback defers to the C library, which is faster one value at a time.
+
+#include "Vec.h"
+
+namespace OptionLib::Simd {
+namespace {
+
+    inline constexpr double kLn2Hi = 6.93147180369123816490e-01;
+    inline constexpr double kLn2Lo = 1.90821492927058770002e-10;
+    inline constexpr double kLog2e = 1.44269504088896338700e+00;
+    inline constexpr double kInvSqrt2 = 0.70710678118654752440;
+    inline constexpr double kInvSqrt2Pi = 0.39894228040143267794;
+
+    // exp(x), flushed to zero below -708 and saturating above 709
+    template <class V>
+    typename V::Reg exp(typename V::Reg x) {
+        if constexpr (V::width == 1) {
+            return std::exp(x);
+        }
+        using R = typename V::Reg;
+        R lo = V::broadcast(-708.0);
+        R clamped = V::min(V::max(x, lo), V::broadcast(709.0));
+
+        // x = n ln2 + r with |r| <= ln2 / 2
+        R n = V::round(V::mul(clamped, V::broadcast(kLog2e)));
+        R r = V::fnma(n, V::broadcast(kLn2Hi), clamped);
+        r = V::fnma(n, V::broadcast(kLn2Lo), r);
+
+        // Taylor series to degree 13 is accurate to below one ulp on this interval
+        R p = V::broadcast(1.0 / 6227020800.0);
+        p = V::fma(p, r, V::broadcast(1.0 / 479001600.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 39916800.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 3628800.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 362880.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 40320.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 5040.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 720.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 120.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 24.0));
+        p = V::fma(p, r, V::broadcast(1.0 / 6.0));
+        p = V::fma(p, r, V::broadcast(0.5));
+        p = V::fma(p, r, V::broadcast(1.0));
+        p = V::fma(p, r, V::broadcast(1.0));
+
+        R result = V::mul(p, V::pow2n(n));
+        return V::select(V::lt(x, lo), V::broadcast(0.0), result);
+    }
+
+    // Natural logarithm for positive, normal x
+    template <class V>
+    typename V::Reg log(typename V::Reg x) {
+        if constexpr (V::width == 1) {
+            return std::log(x);
+        }
+        using R = typename V::Reg;
+        R e, m;
+        V::split(x, e, m);
+
+        // Recentre the mantissa on [sqrt(1/2), sqrt(2))
+        auto high = V::gt(m, V::broadcast(1.41421356237309504880));
+        m = V::select(high, V::mul(m, V::broadcast(0.5)), m);
+        e = V::select(high, V::add(e, V::broadcast(1.0)), e);
+
+        // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| < 0.1716
+        R f = V::sub(m, V::broadcast(1.0));
+        R s = V::div(f, V::add(m, V::broadcast(1.0)));
+        R z = V::mul(s, s);
+        R p = V::broadcast(1.0 / 23.0);
+        p = V::fma(p, z, V::broadcast(1.0 / 21.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 19.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 17.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 15.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 13.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 11.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 9.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 7.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 5.0));
+        p = V::fma(p, z, V::broadcast(1.0 / 3.0));
+        // 2 s (1 + z p) = f - s (f - 2 z p), which keeps the leading term exact
+        R tail = V::mul(V::mul(V::broadcast(2.0), s), V::mul(z, p));
+        R logm = V::fnma(s, f, V::add(f, tail));
+
+        return V::fma(e, V::broadcast(kLn2Hi), V::fma(e, V::broadcast(kLn2Lo), logm));
+    }
+
+    // sin(2 pi u) and cos(2 pi u). Reducing in turns rather than radians is exact: u - round(u)
+    // and the quarter turn q / 4 are representable, leaving |2 pi r| <= pi / 4 for the Taylor series.
+    template <class V>
+    void sinCos2Pi(typename V::Reg u, typename V::Reg& sine, typename V::Reg& cosine) {
+        if constexpr (V::width == 1) {
+            sine = std::sin(6.283185307179586477 * u);
+            cosine = std::cos(6.283185307179586477 * u);
+            return;
+        }
+        using R = typename V::Reg;
+        R x = V::sub(u, V::round(u));
+        R q = V::round(V::mul(x, V::broadcast(4.0)));
+        R theta = V::mul(V::fnma(q, V::broadcast(0.25), x), V::broadcast(6.283185307179586477));
+        R z = V::mul(theta, theta);
+
+        R c = V::broadcast(1.0 / 20922789888000.0);
+        c = V::fma(c, z, V::broadcast(-1.0 / 87178291200.0));
+        c = V::fma(c, z, V::broadcast(1.0 / 479001600.0));
+        c = V::fma(c, z, V::broadcast(-1.0 / 3628800.0));
+        c = V::fma(c, z, V::broadcast(1.0 / 40320.0));
+        c = V::fma(c, z, V::broadcast(-1.0 / 720.0));
+        c = V::fma(c, z, V::broadcast(1.0 / 24.0));
+        c = V::fma(c, z, V::broadcast(-0.5));
+        c = V::fma(c, z, V::broadcast(1.0));
+
+        R s = V::broadcast(1.0 / 355687428096000.0);
+        s = V::fma(s, z, V::broadcast(-1.0 / 1307674368000.0));
+        s = V::fma(s, z, V::broadcast(1.0 / 6227020800.0));
+        s = V::fma(s, z, V::broadcast(-1.0 / 39916800.0));
+        s = V::fma(s, z, V::broadcast(1.0 / 362880.0));
+        s = V::fma(s, z, V::broadcast(-1.0 / 5040.0));
+        s = V::fma(s, z, V::broadcast(1.0 / 120.0));
+        s = V::fma(s, z, V::broadcast(-1.0 / 6.0));
+        s = V::fma(V::mul(s, z), theta, theta);
+
+        // Rotate by q quarter turns, q in {-2, ..., 2}
+        R zero = V::broadcast(0.0);
+        auto halfTurn = V::gt(V::abs(q), V::broadcast(1.5));
+        auto quarterTurn = V::gt(V::abs(q), V::broadcast(0.5));
+        cosine = V::select(halfTurn, V::sub(zero, c), V::select(quarterTurn, V::sub(zero, V::mul(q, s)), c));
+        sine = V::select(halfTurn, V::sub(zero, s), V::select(quarterTurn, V::mul(q, c), s));
+    }
+
+    // erfc(z) for z >= 0 (Chebyshev expansion from Numerical Recipes, 3rd ed., section 6.2.2)
+    template <class V>
+    typename V::Reg erfcNonNegative(typename V::Reg z) {
+        using R = typename V::Reg;
+        static constexpr double cof[28] = {
+            -1.3026537197817094, 6.4196979235649026e-1, 1.9476473204185836e-2,
+            -9.561514786808631e-3, -9.46595344482036e-4, 3.66839497852761e-4,
+            4.2523324806907e-5, -2.0278578112534e-5, -1.624290004647e-6,
+            1.303655835580e-6, 1.5626441722e-8, -8.5238095915e-8,
+            6.529054439e-9, 5.059343495e-9, -9.91364156e-10,
+            -2.27365122e-10, 9.6467911e-11, 2.394038e-12,
+            -6.886027e-12, 8.94487e-13, 3.13092e-13,
+            -1.12708e-13, 3.81e-16, 7.106e-15,
+            -1.523e-15, -9.4e-17, 1.21e-16,
+            -2.8e-17
+        };
+        R t = V::div(V::broadcast(2.0), V::add(V::broadcast(2.0), z));
+        R ty = V::fma(V::broadcast(4.0), t, V::broadcast(-2.0));
+        R d = V::broadcast(0.0);
+        R dd = V::broadcast(0.0);
+        for (int j = 27; j > 0; --j) {
+            R tmp = d;
+            d = V::add(V::sub(V::mul(ty, d), dd), V::broadcast(cof[j]));
+            dd = tmp;
+        }
+        R arg = V::sub(V::fma(V::broadcast(0.5), V::fma(ty, d, V::broadcast(cof[0])), V::mul(V::sub(V::broadcast(0.0), z), z)), dd);
+        return V::mul(t, exp<V>(arg));
+    }
+
+    // Standard normal cumulative distribution function
+    template <class V>
+    typename V::Reg normalCdf(typename V::Reg x) {
+        if constexpr (V::width == 1) {
+            return 0.5 * std::erfc(-x * kInvSqrt2);
+        }
+        using R = typename V::Reg;
+        R tail = V::mul(V::broadcast(0.5), erfcNonNegative<V>(V::mul(V::abs(x), V::broadcast(kInvSqrt2))));
+        return V::select(V::lt(x, V::broadcast(0.0)), tail, V::sub(V::broadcast(1.0), tail));
+    }
+
+    // Standard normal probability density function
+    template <class V>
+    typename V::Reg normalPdf(typename V::Reg x) {
+        return V::mul(V::broadcast(kInvSqrt2Pi), exp<V>(V::mul(V::broadcast(-0.5), V::mul(x, x))));
+    }
+
+    // Inverse of normalCdf for p in (0, 1), to a relative accuracy of about 1e-9 (Acklam's rational
+    // approximations: one for the central region, one for the tails)
+    template <class V>
+    typename V::Reg inverseNormalCdf(typename V::Reg p) {
+        using R = typename V::Reg;
+        static constexpr double a[6] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                        1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+        static constexpr double b[5] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                        6.680131188771972e+01, -1.328068155288572e+01};
+        static constexpr double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                        -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+        static constexpr double d[4] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                        3.754408661907416e+00};
+        const R one = V::broadcast(1.0);
+
+        R q = V::sub(p, V::broadcast(0.5));
+        R r = V::mul(q, q);
+        R num = V::broadcast(a[0]);
+        R den = V::broadcast(b[0]);
+        for (int k = 1; k < 6; ++k) {
+            num = V::fma(num, r, V::broadcast(a[k]));
+        }
+        for (int k = 1; k < 5; ++k) {
+            den = V::fma(den, r, V::broadcast(b[k]));
+        }
+        R central = V::div(V::mul(num, q), V::fma(den, r, one));
+
+        // Lower tail at min(p, 1 - p), reflected for the upper tail
+        R u = V::sqrt(V::mul(V::broadcast(-2.0), log<V>(V::min(p, V::sub(one, p)))));
+        num = V::broadcast(c[0]);
+        den = V::broadcast(d[0]);
+        for (int k = 1; k < 6; ++k) {
+            num = V::fma(num, u, V::broadcast(c[k]));
+        }
+        for (int k = 1; k < 4; ++k) {
+            den = V::fma(den, u, V::broadcast(d[k]));
+        }
+        R tail = V::div(num, V::fma(den, u, one));
+        tail = V::select(V::gt(q, V::broadcast(0.0)), V::sub(V::broadcast(0.0), tail), tail);
+
+        return V::select(V::gt(V::abs(q), V::broadcast(0.47575)), tail, central);
+    }
+
+} // namespace
+} // namespace OptionLib::Simd
+
+#endif //OPTIONLIB_SIMD_VECMATH_H
@@ -0,0 +1,65 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <type_traits>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+
+TEST(Asset, VersionIncreasesOnEveryChange) {
+    Asset asset("AAPL", 100.0);
+    auto v0 = asset.getVersion();
+
+    asset.set(Param::volatility, 0.2);
+    auto v1 = asset.getVersion();
+    asset.setSpotPrice(101.0);
+    auto v2 = asset.getVersion();
+
+    EXPECT_LT(v0, v1);
+    EXPECT_LT(v1, v2);
+    EXPECT_DOUBLE_EQ(asset.getSpotPrice(), 101.0);
+}
+
+TEST(Asset, SnapshotIsAnIndependentCopy) {
+    static_assert(std::is_trivially_copyable_v<MarketSnapshot>);
+
+    Asset asset("AAPL", 100.0);
+    asset.set(Param::riskFreeRate, 0.05);
+    MarketSnapshot snapshot = asset.snapshot();
+
+    asset.set(Param::riskFreeRate, 0.01);
+    asset.setSpotPrice(90.0);
+
+    EXPECT_DOUBLE_EQ(snapshot.get(Param::riskFreeRate), 0.05);
+    EXPECT_DOUBLE_EQ(snapshot.spotPrice, 100.0);
+    EXPECT_LT(snapshot.version, asset.getVersion());
+}
+
+TEST(Asset, MissingParameterThrows) {
+    Asset asset("AAPL", 100.0);
+    asset.set(Param::volatility, 0.2);
+
+    EXPECT_TRUE(asset.has(Param::volatility));
+    EXPECT_FALSE(asset.has(Param::volOfVol));
+    EXPECT_THROW((void)asset.get(Param::volOfVol), std::runtime_error);
+    EXPECT_THROW((void)asset.snapshot().get(Param::volOfVol), std::runtime_error);
+}
+
+TEST(Asset, OptionTermsVersionTracksItsOptions) {
+    AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+    AssetSP other = Factory::makeSharedAsset("MSFT", 100.0);
+    Option option(asset, 100.0, 1.0, OptionType::Call);
+    const auto terms = asset->getOptionTermsVersion();
+    const auto market = asset->getVersion();
+
+    option.setStrikePrice(105.0);
+    option.setType(OptionType::Put);
+    EXPECT_EQ(asset->getOptionTermsVersion(), terms + 2);
+    EXPECT_EQ(asset->getVersion(), market);
+    EXPECT_EQ(other->getOptionTermsVersion(), 0u);
+
+    asset->setSpotPrice(101.0);
+    EXPECT_EQ(asset->getOptionTermsVersion(), terms + 2);
+}
@@ -0,0 +1,227 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    AssetSP makeAsset() {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.05);
+        return asset;
+    }
+
+    Option makeOption(const AssetSP& asset, OptionType type, ExerciseStyle style, std::vector<double> dates = {}) {
+        Option option(asset, 100.0, 1.0, type);
+        option.setExerciseStyle(style, std::move(dates));
+        return option;
+    }
+
+} // namespace
+
+TEST(BinomialExercise, AmericanPutMatchesReference) {
+    AssetSP asset = makeAsset();
+    Binomial model;
+    const double american = model.price(makeOption(asset, OptionType::Put, ExerciseStyle::American));
+    const double european = model.price(makeOption(asset, OptionType::Put, ExerciseStyle::European));
+
+    EXPECT_NEAR(american, 6.0904, 2e-3);
+    EXPECT_NEAR(european, BlackScholes().price(Option(asset, 100.0, 1.0, OptionType::Put)), 2e-3);
+    EXPECT_GT(american - european, 0.5);
+}
+
+TEST(BinomialExercise, AmericanCallWithoutDividendsIsEuropean) {
+    AssetSP asset = makeAsset();
+    Binomial model;
+    EXPECT_NEAR(model.price(makeOption(asset, OptionType::Call, ExerciseStyle::American)),
+                model.price(makeOption(asset, OptionType::Call, ExerciseStyle::European)), 1e-10);
+}
+
+TEST(BinomialExercise, BermudanLiesBetweenEuropeanAndAmerican) {
+    AssetSP asset = makeAsset();
+    Binomial model;
+    const double european = model.price(makeOption(asset, OptionType::Put, ExerciseStyle::European));
+    const double american = model.price(makeOption(asset, OptionType::Put, ExerciseStyle::American));
+    const double quarterly = model.price(makeOption(asset, OptionType::Put, ExerciseStyle::Bermudan, {0.75, 0.25, 0.5}));
+    std::vector<double> weekly;
+    for (int week = 1; week <= 52; ++week) {
+        weekly.push_back(week / 52.0);
+    }
+    const double weeklyPrice = model.price(makeOption(asset, OptionType::Put, ExerciseStyle::Bermudan, weekly));
+
+    EXPECT_GT(quarterly, european);
+    EXPECT_GT(weeklyPrice, quarterly);
+    EXPECT_LT(weeklyPrice, american);
+    EXPECT_NEAR(weeklyPrice, american, 0.02);
+}
+
+TEST(BinomialExercise, IndependentOfThreadCount) {
+    AssetSP asset = makeAsset();
+    Option put = makeOption(asset, OptionType::Put, ExerciseStyle::American);
+    EXPECT_EQ(Binomial(ExecutionContext::serial()).price(put), Binomial(ExecutionContext(3)).price(put));
+}
+
+TEST(BinomialExercise, OtherModelsRejectEarlyExercise) {
+    AssetSP asset = makeAsset();
+    asset->set(Param::meanReversion, 2.0);
+    asset->set(Param::volOfVol, 0.5);
+    asset->set(Param::longTermVariance, 0.04);
+    asset->set(Param::hestonCorrelation, -0.7);
+    Option put = makeOption(asset, OptionType::Put, ExerciseStyle::American);
+
+    EXPECT_THROW((void)BlackScholes().price(put), std::invalid_argument);
+    EXPECT_THROW((void)Heston().price(put), std::invalid_argument);
+    EXPECT_THROW((void)MonteCarlo().price(put), std::invalid_argument);
+    EXPECT_THROW((void)HestonMonteCarlo().price(put), std::invalid_argument);
+}
+
+TEST(BinomialLattice, LeisenReimerConvergesToBlackScholes) {
+    AssetSP asset = makeAsset();
+    Binomial::Settings settings;
+    settings.lattice = Lattice::LeisenReimer;
+    settings.numSteps = 200;        // rounded up to 201
+    Binomial model(settings);
+    for (double K : {80.0, 100.0, 125.0}) {
+        for (OptionType type : {OptionType::Call, OptionType::Put}) {
+            Option option(asset, K, 1.0, type);
+            EXPECT_NEAR(model.price(option), BlackScholes().price(option), 2e-5) << "K=" << K;
+        }
+    }
+}
+
+TEST(BinomialLattice, SmoothingWithRichardsonConvergesToBlackScholes) {
+    AssetSP asset = makeAsset();
+    Binomial::Settings settings;
+    settings.numSteps = 500;
+    settings.smoothing = true;
+    settings.richardson = true;
+    Binomial model(settings);
+    for (double K : {90.0, 100.0, 110.0}) {
+        Option put(asset, K, 1.0, OptionType::Put);
+        EXPECT_NEAR(model.price(put), BlackScholes().price(put), 1e-4) << "K=" << K;
+    }
+}
+
+TEST(BinomialLattice, FewStepsMatchAmericanReference) {
+    // Reference from a 20001-step Leisen-Reimer tree with Richardson extrapolation
+    AssetSP asset = makeAsset();
+    Option put = makeOption(asset, OptionType::Put, ExerciseStyle::American);
+    const double reference = 6.090371;
+
+    Binomial::Settings leisenReimer;
+    leisenReimer.lattice = Lattice::LeisenReimer;
+    leisenReimer.numSteps = 401;
+    leisenReimer.richardson = true;
+    EXPECT_NEAR(Binomial(leisenReimer).price(put), reference, 2e-4);
+
+    Binomial::Settings smoothed;
+    smoothed.numSteps = 400;
+    smoothed.smoothing = true;
+    smoothed.richardson = true;
+    EXPECT_NEAR(Binomial(smoothed).price(put), reference, 3e-4);
+}
+
+TEST(BinomialLattice, TargetAccuracyChoosesSteps) {
+    AssetSP asset = makeAsset();
+    Option put = makeOption(asset, OptionType::Put, ExerciseStyle::American);
+    Binomial::Settings settings;
+    settings.lattice = Lattice::LeisenReimer;
+    settings.richardson = true;
+    settings.numSteps = 3;          // ignored once a target accuracy is set
+    settings.targetAccuracy = 1e-4;
+    Binomial model(settings);
+    EXPECT_NEAR(model.price(put), 6.090371, 1e-4);
+    EXPECT_EQ(model.getSettings().targetAccuracy, 1e-4);
+}
+
+TEST(BinomialLattice, DeepHighVolatilityTreeStaysFinite) {
+    // sigma sqrt(T) = 4.1: at 2^15 steps the extreme node spots lie beyond the double range
+    AssetSP asset = Factory::makeSharedAsset("VOL", 100.0);
+    asset->set(Param::volatility, 1.3);
+    asset->set(Param::riskFreeRate, 0.03);
+    Binomial::Settings settings;
+    settings.targetAccuracy = 1e-12;    // unreachable, so the steps double up to the cap
+    Binomial model(settings);
+
+    const Option call(asset, 100.0, 10.0, OptionType::Call);
+    const double price = model.price(call);
+    ASSERT_TRUE(std::isfinite(price));
+    EXPECT_NEAR(price, BlackScholes().price(call), 1e-3);
+}
+
+TEST(BinomialGreeks, TreeGreeksMatchBlackScholes) {
+    AssetSP asset = makeAsset();
+    Binomial::Settings settings;
+    settings.numSteps = 500;
+    settings.smoothing = true;
+    settings.richardson = true;
+    Binomial model(settings);
+    for (double K : {90.0, 100.0, 110.0}) {
+        for (OptionType type : {OptionType::Call, OptionType::Put}) {
+            Option option(asset, K, 1.0, type);
+            Valuation valuation = model.priceWithGreeks(option);
+            Greeks expected = BlackScholes().computeGreeks(option);
+            EXPECT_NEAR(valuation.price, model.price(option), 1e-12);
+            EXPECT_NEAR(valuation.greeks.delta, expected.delta, 1e-4) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.gamma, expected.gamma, 1e-4) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.theta, expected.theta, 1e-3) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.vega, expected.vega, 0.05) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.rho, expected.rho, 0.01) << "K=" << K;
+        }
+    }
+}
+
+TEST(BinomialGreeks, AmericanTreeGreeksMatchFiniteDifferences) {
+    Binomial::Settings settings;
+    settings.lattice = Lattice::LeisenReimer;
+    settings.numSteps = 301;
+    settings.richardson = true;
+    Binomial model(settings);
+    auto priceAt = [&](double spot, double expiry) {
+        AssetSP asset = makeAsset();
+        asset->setSpotPrice(spot);
+        Option put(asset, 100.0, expiry, OptionType::Put);
+        put.setExerciseStyle(ExerciseStyle::American);
+        return model.price(put);
+    };
+
+    Valuation valuation = model.priceWithGreeks(makeOption(makeAsset(), OptionType::Put, ExerciseStyle::American));
+    const double center = priceAt(100.0, 1.0);
+    EXPECT_NEAR(valuation.greeks.delta, (priceAt(101.0, 1.0) - priceAt(99.0, 1.0)) / 2.0, 1e-3);
+    EXPECT_NEAR(valuation.greeks.gamma, priceAt(101.0, 1.0) - 2.0 * center + priceAt(99.0, 1.0), 5e-4);
+    EXPECT_NEAR(valuation.greeks.theta, -(priceAt(100.0, 1.01) - priceAt(100.0, 0.99)) / 0.02, 5e-3);
+}
+
+TEST(BinomialGreeks, MaskedGreeksMatchFullSet) {
+    AssetSP asset = makeAsset();
+    Binomial::Settings settings;
+    settings.numSteps = 201;
+    Binomial model(settings, ExecutionContext(2));
+    Option put = makeOption(asset, OptionType::Put, ExerciseStyle::American);
+
+    Valuation valuation = model.priceWithGreeks(put);
+    Greeks deltaOnly = model.computeGreeks(put, greekBit(GreekType::Delta));
+    EXPECT_EQ(deltaOnly.delta, valuation.greeks.delta);
+    EXPECT_EQ(deltaOnly.vega, 0.0);
+    EXPECT_EQ(model.computeGreek(put, GreekType::Rho), valuation.greeks.rho);
+}
+
+TEST(BinomialExercise, ValidatesExerciseDates) {
+    Option option(makeAsset(), 100.0, 1.0, OptionType::Put);
+    EXPECT_THROW(option.setExerciseStyle(ExerciseStyle::Bermudan), std::invalid_argument);
+    EXPECT_THROW(option.setExerciseStyle(ExerciseStyle::Bermudan, {0.5, 1.5}), std::invalid_argument);
+    EXPECT_THROW(option.setExerciseStyle(ExerciseStyle::American, {0.5}), std::invalid_argument);
+
+    option.setExerciseStyle(ExerciseStyle::Bermudan, {0.5, 0.25});
+    EXPECT_EQ(option.getExerciseDates(), (std::vector<double>{0.25, 0.5}));
+    option.setExerciseStyle(ExerciseStyle::European);
+    EXPECT_FALSE(option.hasEarlyExercise());
+    EXPECT_TRUE(option.getExerciseDates().empty());
+}
@@ -0,0 +1,202 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    // A spread of moneyness, expiries and vols; 37 contracts so every SIMD width has a remainder
+    struct BatchFixture {
+        std::vector<double> spot, strike, expiry, vol, rate;
+        std::vector<OptionType> type;
+
+        BatchFixture() {
+            for (int i = 0; i < 37; ++i) {
+                spot.push_back(100.0);
+                strike.push_back(40.0 + 4.0 * i);
+                expiry.push_back(0.02 + 0.13 * (i % 11));
+                vol.push_back(0.05 + 0.03 * (i % 9));
+                rate.push_back(0.01 * (i % 6));
+                type.push_back(i % 2 == 0 ? OptionType::Call : OptionType::Put);
+            }
+        }
+
+        [[nodiscard]] BlackScholes::BatchInput input() const {
+            return {spot, strike, expiry, vol, rate, type};
+        }
+    };
+
+    struct BatchResults {
+        std::vector<double> price, delta, gamma, vega, theta, rho;
+        explicit BatchResults(std::size_t n) : price(n), delta(n), gamma(n), vega(n), theta(n), rho(n) {}
+        BlackScholes::BatchOutput output() {
+            return {price, delta, gamma, vega, theta, rho};
+        }
+    };
+
+    const SimdLevel allLevels[] = {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512};
+
+} // namespace
+
+TEST(BlackScholesBatch, MatchesScalarPricerAndGreeks) {
+    BatchFixture fixture;
+    BlackScholes model;
+
+    for (SimdLevel level : allLevels) {
+        setSimdLevel(level);
+        BatchResults results(fixture.spot.size());
+        BlackScholes::priceBatch(fixture.input(), results.output());
+
+        for (std::size_t i = 0; i < fixture.spot.size(); ++i) {
+            auto asset = std::make_shared<Asset>("X", fixture.spot[i]);
+            asset->set(Param::volatility, fixture.vol[i]);
+            asset->set(Param::riskFreeRate, fixture.rate[i]);
+            Option option(asset, fixture.strike[i], fixture.expiry[i], fixture.type[i]);
+
+            EXPECT_NEAR(results.price[i], model.price(option), 1e-10) << "contract " << i;
+            EXPECT_NEAR(results.delta[i], model.computeGreek(option, GreekType::Delta), 1e-12);
+            EXPECT_NEAR(results.gamma[i], model.computeGreek(option, GreekType::Gamma), 1e-12);
+            EXPECT_NEAR(results.vega[i], model.computeGreek(option, GreekType::Vega), 1e-10);
+            EXPECT_NEAR(results.theta[i], model.computeGreek(option, GreekType::Theta), 1e-10);
+            EXPECT_NEAR(results.rho[i], model.computeGreek(option, GreekType::Rho), 1e-10);
+        }
+    }
+    setSimdLevel(detectedSimdLevel());
+}
+
+TEST(BlackScholesBatch, IdenticalAcrossVectorInstructionSets) {
+    if (detectedSimdLevel() < SimdLevel::AVX512) {
+        GTEST_SKIP() << "Needs both AVX2 and AVX-512 kernels";
+    }
+    BatchFixture fixture;
+
+    setSimdLevel(SimdLevel::AVX2);
+    BatchResults reference(fixture.spot.size());
+    BlackScholes::priceBatch(fixture.input(), reference.output());
+
+    setSimdLevel(SimdLevel::AVX512);
+    BatchResults results(fixture.spot.size());
+    BlackScholes::priceBatch(fixture.input(), results.output());
+    EXPECT_EQ(results.price, reference.price);
+    EXPECT_EQ(results.theta, reference.theta);
+    setSimdLevel(detectedSimdLevel());
+}
+
+TEST(BlackScholesBatch, SkipsEmptyOutputsAndValidatesLengths) {
+    BatchFixture fixture;
+    std::vector<double> price(fixture.spot.size(), -1.0);
+    BlackScholes::priceBatch(fixture.input(), {.price = price});
+    for (double p : price) {
+        EXPECT_GE(p, 0.0);
+    }
+
+    auto input = fixture.input();
+    input.strike = input.strike.first(3);
+    EXPECT_THROW(BlackScholes::priceBatch(input, {.price = price}), std::invalid_argument);
+}
+
+namespace {
+
+    // Option chains: strikes 60-180 across four expiries, with a volatility smile
+    struct ChainFixture {
+        std::vector<double> spot, strike, expiry, vol, rate, price;
+        std::vector<OptionType> type;
+
+        explicit ChainFixture(int copies = 1) {
+            for (int copy = 0; copy < copies; ++copy) {
+                for (double T : {0.05, 0.25, 1.0, 3.0}) {
+                    for (int i = 0; i < 13; ++i) {
+                        double K = 60.0 + 10.0 * i;
+                        spot.push_back(100.0);
+                        strike.push_back(K);
+                        expiry.push_back(T);
+                        vol.push_back(0.2 + 0.3 * std::pow(std::log(K / 100.0), 2));
+                        rate.push_back(0.03);
+                        type.push_back(K < 100.0 ? OptionType::Put : OptionType::Call);
+                    }
+                }
+            }
+            price.resize(spot.size());
+            BlackScholes::priceBatch({spot, strike, expiry, vol, rate, type}, {.price = price});
+        }
+
+        [[nodiscard]] BlackScholes::ImpliedVolatilityInput input() const {
+            return {price, spot, strike, expiry, rate, type};
+        }
+    };
+
+} // namespace
+
+TEST(BlackScholesBatch, ImpliedVolatilityRecoversVolatility) {
+    ChainFixture chain;
+    const std::size_t n = chain.spot.size();
+    BlackScholes model;
+
+    for (SimdLevel level : allLevels) {
+        setSimdLevel(level);
+        std::vector<double> vol(n);
+        std::vector<ImpliedVolatilityStatus> status(n);
+        std::vector<unsigned> iterations(n);
+        model.impliedVolatilityBatch(chain.input(), {vol, status, iterations});
+
+        for (std::size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(status[i], ImpliedVolatilityStatus::Converged) << "contract " << i;
+            EXPECT_NEAR(vol[i], chain.vol[i], 1e-12 * chain.vol[i]) << "contract " << i;
+            EXPECT_LE(iterations[i], 4u) << "contract " << i;
+        }
+    }
+    setSimdLevel(detectedSimdLevel());
+}
+
+TEST(BlackScholesBatch, ImpliedVolatilityFlagsPricesOutsideTheBounds) {
+    // Call on 100 struck at 90: intrinsic value 10 + 90 (1 - e^{-rT}), maximum 100
+    std::vector<double> price = {10.0, 100.0, 120.0, 16.0};
+    std::vector<double> spot(4, 100.0), strike(4, 90.0), expiry(4, 1.0), rate(4, 0.05);
+    std::vector<OptionType> type(4, OptionType::Call);
+    std::vector<double> vol(4);
+    std::vector<ImpliedVolatilityStatus> status(4);
+
+    BlackScholes().impliedVolatilityBatch({price, spot, strike, expiry, rate, type}, {vol, status, {}});
+    EXPECT_EQ(status[0], ImpliedVolatilityStatus::BelowIntrinsic);
+    EXPECT_EQ(status[1], ImpliedVolatilityStatus::AboveMaximum);
+    EXPECT_EQ(status[2], ImpliedVolatilityStatus::AboveMaximum);
+    EXPECT_EQ(status[3], ImpliedVolatilityStatus::Converged);
+    EXPECT_TRUE(std::isnan(vol[0]));
+    EXPECT_TRUE(std::isnan(vol[1]));
+    EXPECT_GT(vol[3], 0.0);
+
+    auto shortStrike = strike;
+    shortStrike.pop_back();
+    EXPECT_THROW(BlackScholes().impliedVolatilityBatch({price, spot, shortStrike, expiry, rate, type}, {vol, {}, {}}),
+                 std::invalid_argument);
+}
+
+TEST(BlackScholesBatch, ImpliedVolatilityIsIndependentOfThreads) {
+    // Repeat the chain so the batch spans several blocks of work
+    ChainFixture large(40);
+    const std::size_t n = large.price.size();
+
+    std::vector<double> serial(n), parallel(n);
+    BlackScholes(ExecutionContext::serial()).impliedVolatilityBatch(large.input(), {serial, {}, {}});
+    BlackScholes(ExecutionContext(4)).impliedVolatilityBatch(large.input(), {parallel, {}, {}});
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST(BlackScholesBatch, ImpliedVolatilityOfOneOption) {
+    AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+    asset->set(Param::volatility, 0.27);
+    asset->set(Param::riskFreeRate, 0.04);
+    Option put(asset, 95.0, 0.75, OptionType::Put);
+    BlackScholes model;
+
+    EXPECT_NEAR(model.impliedVolatility(put, model.price(put)), 0.27, 1e-12);
+    EXPECT_EQ(model.impliedVolatility(put, 0.0), 0.0);
+    EXPECT_THROW((void)model.impliedVolatility(put, -1.0), std::invalid_argument);
+}
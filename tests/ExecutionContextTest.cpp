@@ -0,0 +1,69 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+
+TEST(ExecutionContext, ParallelForCoversEveryIndexOnce) {
+    ExecutionContext context(4);
+    std::vector<int> hits(1000, 0);
+    context.parallelFor(0, hits.size(), 7, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ++hits[i];
+        }
+    });
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 1000);
+    EXPECT_EQ(*std::min_element(hits.begin(), hits.end()), 1);
+}
+
+TEST(ExecutionContext, NestedLoopsRunOnPoolThreadsOnly) {
+    ExecutionContext context(2);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> inner{0};
+
+    context.parallelFor(0, 8, 1, [&](std::size_t, std::size_t) {
+        context.parallelFor(0, 64, 4, [&](std::size_t begin, std::size_t end) {
+            inner += static_cast<int>(end - begin);
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+    });
+
+    EXPECT_EQ(inner.load(), 8 * 64);
+    // Two workers plus the calling thread, however deep the nesting
+    EXPECT_LE(threads.size(), 3u);
+}
+
+TEST(ExecutionContext, ExceptionsPropagateToCaller) {
+    ExecutionContext context(2);
+    EXPECT_THROW(context.parallelFor(0, 10, 1, [](std::size_t begin, std::size_t) {
+        if (begin == 5) {
+            throw std::runtime_error("boom");
+        }
+    }), std::runtime_error);
+}
+
+TEST(ExecutionContext, SerialContextRunsInline) {
+    ExecutionContext context = ExecutionContext::serial();
+    EXPECT_EQ(context.concurrency(), 1u);
+
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::size_t> chunkStarts;
+    context.parallelFor(0, 10, 4, [&](std::size_t begin, std::size_t) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        chunkStarts.push_back(begin);
+    });
+    EXPECT_EQ(chunkStarts, (std::vector<std::size_t>{0, 4, 8}));
+}
@@ -0,0 +1,91 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    AssetSP makeAsset(double spot = 100.0) {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", spot);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.05);
+        return asset;
+    }
+
+} // namespace
+
+TEST(FiniteDifference, EuropeanMatchesBlackScholes) {
+    AssetSP asset = makeAsset();
+    FiniteDifference model;
+    for (double K : {80.0, 100.0, 120.0}) {
+        for (OptionType type : {OptionType::Call, OptionType::Put}) {
+            Option option(asset, K, 1.0, type);
+            Valuation valuation = model.priceWithGreeks(option);
+            Greeks expected = BlackScholes().computeGreeks(option);
+            EXPECT_NEAR(valuation.price, BlackScholes().price(option), 1e-3) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.delta, expected.delta, 1e-4) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.gamma, expected.gamma, 1e-4) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.theta, expected.theta, 1e-3) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.vega, expected.vega, 0.05) << "K=" << K;
+            EXPECT_NEAR(valuation.greeks.rho, expected.rho, 0.01) << "K=" << K;
+        }
+    }
+}
+
+TEST(FiniteDifference, AmericanPutMatchesTree) {
+    // Reference from a 20001-step Leisen-Reimer tree with Richardson extrapolation
+    Option put(makeAsset(), 100.0, 1.0, OptionType::Put);
+    put.setExerciseStyle(ExerciseStyle::American);
+    FiniteDifference model;
+    EXPECT_NEAR(model.price(put), 6.090371, 1.5e-3);
+
+    Valuation valuation = model.priceWithGreeks(put);
+    Binomial::Settings settings;
+    settings.numSteps = 2000;
+    Valuation tree = Binomial(settings).priceWithGreeks(put);
+    EXPECT_NEAR(valuation.greeks.delta, tree.greeks.delta, 1e-3);
+    EXPECT_NEAR(valuation.greeks.gamma, tree.greeks.gamma, 5e-4);
+}
+
+TEST(FiniteDifference, BermudanLiesBetweenEuropeanAndAmerican) {
+    AssetSP asset = makeAsset();
+    FiniteDifference model;
+    Option put(asset, 100.0, 1.0, OptionType::Put);
+    const double european = model.price(put);
+    put.setExerciseStyle(ExerciseStyle::Bermudan, {0.25, 0.5, 0.75});
+    const double bermudan = model.price(put);
+    put.setExerciseStyle(ExerciseStyle::American);
+    const double american = model.price(put);
+
+    EXPECT_GT(bermudan, european + 0.1);
+    EXPECT_LT(bermudan, american);
+}
+
+TEST(FiniteDifference, GridGivesBumpedSpotScenarios) {
+    // The grid is sized from max(spot, strike), so every spot below the strike shares it
+    AssetSP asset = makeAsset();
+    FiniteDifference model;
+    Option put(asset, 110.0, 0.5, OptionType::Put);
+    put.setExerciseStyle(ExerciseStyle::American);
+    FiniteDifference::Grid grid = model.solve(put);
+    ASSERT_EQ(grid.spots.size(), model.getSettings().spotNodes);
+
+    for (double spot : {90.0, 97.5, 104.0}) {
+        AssetSP bumped = makeAsset(spot);
+        Option bumpedPut(bumped, 110.0, 0.5, OptionType::Put);
+        bumpedPut.setExerciseStyle(ExerciseStyle::American);
+        EXPECT_NEAR(grid.at(spot).price, model.price(bumpedPut), 1e-4) << "spot=" << spot;
+    }
+    EXPECT_THROW((void)grid.at(-1.0), std::out_of_range);
+}
+
+TEST(FiniteDifference, RejectsPathDependentPayoffs) {
+    auto payoff = std::make_shared<AsianPayoff>(Averaging::Arithmetic, 12);
+    Option asian(makeAsset(), 100.0, 1.0, OptionType::Call, payoff);
+    EXPECT_THROW((void)FiniteDifference().price(asian), std::invalid_argument);
+}
@@ -0,0 +1,61 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    AssetSP makeAsset() {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.05);
+        return asset;
+    }
+
+} // namespace
+
+TEST(Greeks, BlackScholesFusedMatchesClosedForm) {
+    Option call(makeAsset(), 100.0, 1.0, OptionType::Call);
+    Greeks greeks = BlackScholes().computeGreeks(call);
+
+    EXPECT_NEAR(greeks.delta, 0.636831, 1e-6);
+    EXPECT_NEAR(greeks.gamma, 0.018762, 1e-6);
+    EXPECT_NEAR(greeks.vega, 37.524035, 1e-6);
+    EXPECT_NEAR(greeks.theta, -6.414028, 1e-6);
+    EXPECT_NEAR(greeks.rho, 53.232482, 1e-6);
+}
+
+TEST(Greeks, MaskLeavesUnrequestedGreeksAtZero) {
+    Option put(makeAsset(), 110.0, 0.5, OptionType::Put);
+    BlackScholes model;
+    Greeks greeks = model.computeGreeks(put, greekBit(GreekType::Delta) | greekBit(GreekType::Rho));
+
+    EXPECT_DOUBLE_EQ(greeks.delta, model.computeGreek(put, GreekType::Delta));
+    EXPECT_DOUBLE_EQ(greeks.rho, model.computeGreek(put, GreekType::Rho));
+    EXPECT_EQ(greeks.gamma, 0.0);
+    EXPECT_EQ(greeks.vega, 0.0);
+    EXPECT_EQ(greeks.theta, 0.0);
+}
+
+TEST(Greeks, PortfolioMatrixMatchesGreekVectors) {
+    AssetSP asset = makeAsset();
+    Portfolio portfolio(Factory::makeSharedModel<BlackScholes>());
+    portfolio.addOption(Factory::makeSharedOption(asset, 90.0, 0.5, OptionType::Call));
+    portfolio.addOption(Factory::makeSharedOption(asset, 100.0, 1.0, OptionType::Put));
+    portfolio.addOption(Factory::makeSharedOption(asset, 120.0, 2.0, OptionType::Call));
+
+    std::vector<Greeks> matrix = portfolio.greekMatrix();
+    ASSERT_EQ(matrix.size(), 3u);
+
+    for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+        std::vector<double> column = portfolio.greekVector(type);
+        for (std::size_t i = 0; i < matrix.size(); ++i) {
+            EXPECT_DOUBLE_EQ(matrix[i].get(type), column[i]);
+        }
+    }
+}
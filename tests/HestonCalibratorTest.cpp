@@ -0,0 +1,93 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    const HestonCalibrator::Parameters truth = {0.25, 1.8, 0.05, 0.6, -0.6};
+
+    void setParameters(Asset& asset, const HestonCalibrator::Parameters& p) {
+        asset.set(Param::volatility, p.volatility);
+        asset.set(Param::meanReversion, p.meanReversion);
+        asset.set(Param::longTermVariance, p.longTermVariance);
+        asset.set(Param::volOfVol, p.volOfVol);
+        asset.set(Param::hestonCorrelation, p.correlation);
+    }
+
+    double blackScholesPrice(double S, double K, double T, double vol, double r, OptionType type) {
+        double price = 0.0;
+        BlackScholes::priceBatch({{&S, 1}, {&K, 1}, {&T, 1}, {&vol, 1}, {&r, 1}, {&type, 1}}, {.price = {&price, 1}});
+        return price;
+    }
+
+    // Implied volatilities of Heston prices under `truth`, by bisection
+    std::vector<VolatilityQuote> makeSurface() {
+        AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+        asset->set(Param::riskFreeRate, 0.02);
+        setParameters(*asset, truth);
+        Heston heston;
+
+        std::vector<VolatilityQuote> quotes;
+        for (double T : {0.25, 0.5, 1.0, 2.0}) {
+            for (double K : {80.0, 90.0, 100.0, 110.0, 120.0}) {
+                OptionType type = K < 100.0 ? OptionType::Put : OptionType::Call;
+                double target = heston.price(Option(asset, K, T, type));
+                double low = 0.01, high = 2.0;
+                for (int i = 0; i < 100; ++i) {
+                    double mid = 0.5 * (low + high);
+                    (blackScholesPrice(100.0, K, T, mid, 0.02, type) < target ? low : high) = mid;
+                }
+                quotes.push_back({K, T, 0.5 * (low + high), type});
+            }
+        }
+        return quotes;
+    }
+
+} // namespace
+
+TEST(HestonCalibrator, RecoversParametersOfSyntheticSurface) {
+    const std::vector<VolatilityQuote> quotes = makeSurface();
+    Asset asset("SPX", 100.0);
+    asset.set(Param::riskFreeRate, 0.02);
+    setParameters(asset, {0.2, 1.0, 0.04, 0.4, -0.3});
+
+    HestonCalibrator calibrator(ExecutionContext(3));
+    HestonCalibrator::Result result = calibrator.calibrate(asset, quotes);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_LT(result.rootMeanSquareError, 1e-6);
+    EXPECT_NEAR(result.parameters.volatility, truth.volatility, 1e-3);
+    EXPECT_NEAR(result.parameters.meanReversion, truth.meanReversion, 2e-2);
+    EXPECT_NEAR(result.parameters.longTermVariance, truth.longTermVariance, 1e-3);
+    EXPECT_NEAR(result.parameters.volOfVol, truth.volOfVol, 1e-2);
+    EXPECT_NEAR(result.parameters.correlation, truth.correlation, 1e-2);
+    EXPECT_EQ(asset.get(Param::volOfVol), result.parameters.volOfVol);
+    EXPECT_GE(result.evaluations, result.iterations);
+    EXPECT_GT(result.wallTime.count(), 0);
+}
+
+TEST(HestonCalibrator, WarmStartNeedsFewerIterations) {
+    const std::vector<VolatilityQuote> quotes = makeSurface();
+    Asset asset("SPX", 100.0);
+    asset.set(Param::riskFreeRate, 0.02);
+
+    HestonCalibrator calibrator;
+    HestonCalibrator::Result cold = calibrator.calibrate(asset, quotes);
+    HestonCalibrator::Result warm = calibrator.calibrate(asset, quotes);
+
+    EXPECT_TRUE(cold.converged);
+    EXPECT_TRUE(warm.converged);
+    EXPECT_LT(warm.iterations, cold.iterations);
+    // Each run prices on the truncation ranges of its own starting point, so both fits are exact
+    // only to rounding
+    EXPECT_LE(warm.rootMeanSquareError, std::max(cold.rootMeanSquareError, 1e-12));
+}
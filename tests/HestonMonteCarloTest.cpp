@@ -0,0 +1,121 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    AssetSP makeHestonAsset(double volOfVol = 0.5) {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.03);
+        asset->set(Param::meanReversion, 2.0);
+        asset->set(Param::volOfVol, volOfVol);
+        asset->set(Param::longTermVariance, 0.04);
+        asset->set(Param::hestonCorrelation, -0.7);
+        return asset;
+    }
+
+    HestonMonteCarlo makeModel(std::uint64_t paths, unsigned stepsPerYear) {
+        MonteCarlo::Settings settings;
+        settings.maxPaths = paths;
+        settings.antithetic = true;
+        HestonMonteCarlo model(settings);
+        model.setStepsPerYear(stepsPerYear);
+        return model;
+    }
+
+} // namespace
+
+TEST(HestonMonteCarlo, VanillasMatchFourierPrice) {
+    AssetSP asset = makeHestonAsset();
+    HestonMonteCarlo model = makeModel(60000, 24);
+    Heston fourier;
+
+    for (double K : {85.0, 100.0, 115.0}) {
+        for (OptionType type : {OptionType::Call, OptionType::Put}) {
+            Option option(asset, K, 1.0, type);
+            MonteCarlo::Estimate estimate = model.estimate(option);
+            EXPECT_NEAR(estimate.price, fourier.price(option), 4.0 * estimate.standardError + 0.02)
+                << "K=" << K << (type == OptionType::Call ? " call" : " put");
+        }
+    }
+}
+
+TEST(HestonMonteCarlo, MartingaleCorrectionKeepsForwardUnbiased) {
+    // A large vol of vol sends most steps through the exponential branch of the QE scheme
+    AssetSP asset = makeHestonAsset(1.2);
+    MonteCarlo::Settings settings;
+    settings.antithetic = true;
+    settings.controlVariate = ControlVariate::TerminalSpot;
+    HestonMonteCarlo model(settings);
+    model.setStepsPerYear(4);
+    Option call(asset, 100.0, 2.0, OptionType::Call);
+
+    MonteCarlo::Checkpoint checkpoint = model.simulate(call, 100000);
+    const double n = static_cast<double>(checkpoint.numSamples);
+    const double mean = checkpoint.sumY / n;
+    const double standardError = std::sqrt((checkpoint.sumYY / n - mean * mean) / (n - 1.0));
+    EXPECT_NEAR(checkpoint.discountFactor * mean, 100.0, 4.0 * checkpoint.discountFactor * standardError);
+}
+
+TEST(HestonMonteCarlo, IndependentOfThreadCount) {
+    AssetSP asset = makeHestonAsset();
+    Option put(asset, 95.0, 0.5, OptionType::Put);
+
+    HestonMonteCarlo serial(ExecutionContext::serial());
+    HestonMonteCarlo pooled(ExecutionContext(3));
+    serial.setStepsPerYear(8);
+    pooled.setStepsPerYear(8);
+    const std::uint64_t paths = 2 * MonteCarlo::PathBlockSize + 500;
+
+    EXPECT_EQ(serial.simulate(put, paths).price(), pooled.simulate(put, paths).price());
+}
+
+TEST(HestonMonteCarlo, BarrierInPlusOutEqualsVanilla) {
+    AssetSP asset = makeHestonAsset();
+    HestonMonteCarlo model = makeModel(50000, 24);
+    auto downAndOut = std::make_shared<BarrierPayoff>(BarrierType::DownAndOut, 90.0, 12);
+    auto downAndIn = std::make_shared<BarrierPayoff>(BarrierType::DownAndIn, 90.0, 12);
+
+    const double out = model.price(Option(asset, 100.0, 1.0, OptionType::Call, downAndOut));
+    const double in = model.price(Option(asset, 100.0, 1.0, OptionType::Call, downAndIn));
+    const double vanilla = Heston().price(Option(asset, 100.0, 1.0, OptionType::Call));
+
+    EXPECT_GT(out, 0.0);
+    EXPECT_GT(in, 0.0);
+    EXPECT_NEAR(in + out, vanilla, 0.15);
+}
+
+TEST(HestonMonteCarlo, DeltaMatchesFourierDifference) {
+    AssetSP asset = makeHestonAsset();
+    HestonMonteCarlo model = makeModel(40000, 12);
+    Option call(asset, 100.0, 1.0, OptionType::Call);
+
+    AssetSP up = makeHestonAsset();
+    AssetSP down = makeHestonAsset();
+    up->setSpotPrice(101.0);
+    down->setSpotPrice(99.0);
+    Heston fourier;
+    const double delta = (fourier.price(Option(up, 100.0, 1.0, OptionType::Call))
+                        - fourier.price(Option(down, 100.0, 1.0, OptionType::Call))) / 2.0;
+
+    Valuation valuation = model.priceWithGreeks(call);
+    EXPECT_NEAR(valuation.greeks.delta, delta, 0.02);
+    EXPECT_GT(valuation.greeks.vega, 0.0);
+}
+
+TEST(HestonMonteCarlo, RejectsQuasiRandomSampling) {
+    AssetSP asset = makeHestonAsset();
+    MonteCarlo::Settings settings;
+    settings.sampling = Sampling::Sobol;
+    HestonMonteCarlo model(settings);
+    EXPECT_THROW((void)model.price(Option(asset, 100.0, 1.0, OptionType::Call)), std::invalid_argument);
+}
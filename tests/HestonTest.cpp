@@ -0,0 +1,219 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    AssetSP makeHestonAsset() {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.03);
+        asset->set(Param::meanReversion, 2.0);
+        asset->set(Param::volOfVol, 0.5);
+        asset->set(Param::longTermVariance, 0.04);
+        asset->set(Param::hestonCorrelation, -0.7);
+        return asset;
+    }
+
+} // namespace
+
+TEST(HestonTolerance, AdaptivePricesWithinTolerance) {
+    AssetSP asset = makeHestonAsset();
+    Heston exact;
+    exact.setTolerance(1e-13);
+    for (double tolerance : {1e-4, 1e-6, 1e-8}) {
+        Heston model;
+        model.setTolerance(tolerance);
+        for (double T : {0.05, 0.5, 2.0, 10.0}) {
+            for (double K : {50.0, 90.0, 100.0, 110.0, 200.0}) {
+                for (OptionType type : {OptionType::Call, OptionType::Put}) {
+                    Option option(asset, K, T, type);
+                    EXPECT_NEAR(model.price(option), exact.price(option), tolerance) << "K=" << K << " T=" << T;
+                }
+            }
+        }
+    }
+}
+
+TEST(HestonTolerance, SeriesBoundHoldsAcrossParameters) {
+    // The term count comes from a bound on |phi|, so it must hold where phi decays slowly too
+    AssetSP asset = makeHestonAsset();
+    Heston exact;
+    exact.setTolerance(1e-13);
+    Heston model;
+    model.setTolerance(1e-7);
+    for (double zeta : {0.1, 1.0}) {
+        for (double rho : {-0.95, 0.0, 0.5}) {
+            asset->set(Param::volOfVol, zeta);
+            asset->set(Param::hestonCorrelation, rho);
+            for (double T : {0.1, 5.0}) {
+                for (double K : {70.0, 100.0, 140.0}) {
+                    Option option(asset, K, T, OptionType::Put);
+                    EXPECT_NEAR(model.price(option), exact.price(option), 1e-7)
+                        << "zeta=" << zeta << " rho=" << rho << " K=" << K << " T=" << T;
+                }
+            }
+        }
+    }
+}
+
+TEST(HestonTolerance, AdaptiveGreeksWithinTolerance) {
+    AssetSP asset = makeHestonAsset();
+    Heston exact;
+    exact.setTolerance(1e-13);
+    Heston model;
+    model.setTolerance(1e-6);
+    for (double T : {0.05, 1.0}) {
+        for (double K : {80.0, 100.0, 120.0}) {
+            const Option option(asset, K, T, OptionType::Call);
+            const Greeks adaptive = model.priceWithGreeks(option).greeks;
+            const Greeks reference = exact.priceWithGreeks(option).greeks;
+            for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+                EXPECT_NEAR(adaptive.get(type), reference.get(type), 1e-5) << "K=" << K << " T=" << T;
+            }
+        }
+    }
+}
+
+TEST(HestonTolerance, HeavyLeftTailWidensRange) {
+    // Strong negative correlation and a large vol of vol put mass far below the 24-sigma range
+    AssetSP asset = makeHestonAsset();
+    asset->set(Param::volatility, 0.1);
+    asset->set(Param::meanReversion, 0.5);
+    asset->set(Param::volOfVol, 1.0);
+    asset->set(Param::longTermVariance, 0.02);
+    asset->set(Param::hestonCorrelation, -0.9);
+    Heston model;
+    model.setTolerance(1e-8);
+    Heston loose;
+    loose.setTolerance(1e-5);
+
+    // Reference from the Lewis integral at high resolution
+    const Option put(asset, 100.0, 3.0, OptionType::Put);
+    EXPECT_NEAR(model.price(put), 2.125870145, 1e-7);
+    EXPECT_NEAR(loose.price(put), 2.125870145, 1e-5);
+}
+
+TEST(HestonTolerance, ChainMatchesSinglePrices) {
+    AssetSP asset = makeHestonAsset();
+    Heston model;
+    model.setTolerance(1e-7);
+    const std::vector<double> strikes = {40.0, 80.0, 100.0, 125.0, 300.0};
+    std::vector<double> chain = model.priceChain(*asset, 1.0, strikes, OptionType::Put);
+    for (std::size_t k = 0; k < strikes.size(); ++k) {
+        EXPECT_NEAR(chain[k], model.price(Option(asset, strikes[k], 1.0, OptionType::Put)), 2e-7) << "K=" << strikes[k];
+    }
+    model.setTolerance(-1.0);
+    EXPECT_EQ(model.getTolerance(), 0.0);
+}
+
+TEST(HestonChain, MatchesSingleOptionPrices) {
+    AssetSP asset = makeHestonAsset();
+    Heston model;
+    std::vector<double> strikes;
+    for (double K = 60.0; K <= 150.0; K += 2.5) {
+        strikes.push_back(K);
+    }
+
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        for (double T : {0.25, 1.0, 3.0}) {
+            std::vector<double> chain = model.priceChain(*asset, T, strikes, type);
+            ASSERT_EQ(chain.size(), strikes.size());
+            for (std::size_t k = 0; k < strikes.size(); ++k) {
+                EXPECT_NEAR(chain[k], model.price(Option(asset, strikes[k], T, type)), 1e-10) << "K=" << strikes[k] << " T=" << T;
+            }
+        }
+    }
+}
+
+TEST(HestonChain, SatisfiesPutCallParity) {
+    AssetSP asset = makeHestonAsset();
+    Heston model(ExecutionContext(3));
+    const std::vector<double> strikes = {80.0, 95.0, 100.0, 105.0, 120.0};
+    const double T = 0.5;
+
+    std::vector<double> calls = model.priceChain(*asset, T, strikes, OptionType::Call);
+    std::vector<double> puts = model.priceChain(*asset, T, strikes, OptionType::Put);
+    for (std::size_t k = 0; k < strikes.size(); ++k) {
+        EXPECT_NEAR(calls[k] - puts[k], 100.0 - strikes[k] * std::exp(-0.03 * T), 1e-9);
+    }
+}
+
+TEST(HestonChain, BatchGroupsRowsIntoChains) {
+    AssetSP asset = makeHestonAsset();
+    Heston model;
+    std::vector<Option> contracts;
+    for (int i = 0; i < 12; ++i) {
+        const OptionType type = i % 3 == 0 ? OptionType::Put : OptionType::Call;
+        contracts.emplace_back(asset, 85.0 + 2.5 * i, i % 2 == 0 ? 0.5 : 1.5, type);
+    }
+    std::vector<double> strikes, expiries;
+    std::vector<OptionType> types;
+    std::vector<const Option*> options;
+    for (const Option& option : contracts) {
+        strikes.push_back(option.getStrikePrice());
+        expiries.push_back(option.getTimeToExpiry());
+        types.push_back(option.getType());
+        options.push_back(&option);
+    }
+
+    std::vector<double> prices(contracts.size());
+    model.priceBatch({asset.get(), strikes, expiries, types, options}, prices);
+    for (std::size_t i = 0; i < contracts.size(); ++i) {
+        EXPECT_NEAR(prices[i], model.price(contracts[i]), 1e-10) << "row " << i;
+    }
+}
+
+TEST(HestonGreeks, MatchFiniteDifferencesOfPrice) {
+    Heston model;
+    auto priceAt = [&](double spot, double vol, double rate, double K, double T, OptionType type) {
+        AssetSP asset = makeHestonAsset();
+        asset->setSpotPrice(spot);
+        asset->set(Param::volatility, vol);
+        asset->set(Param::riskFreeRate, rate);
+        return model.price(Option(asset, K, T, type));
+    };
+
+    AssetSP asset = makeHestonAsset();
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        for (double K : {80.0, 100.0, 125.0}) {
+            for (double T : {0.5, 2.0}) {
+                Valuation valuation = model.priceWithGreeks(Option(asset, K, T, type));
+                const double dS = 0.01, dV = 1e-4, dR = 1e-5, dT = 1e-5;
+                const double center = priceAt(100.0, 0.2, 0.03, K, T, type);
+                const double up = priceAt(100.0 + dS, 0.2, 0.03, K, T, type);
+                const double down = priceAt(100.0 - dS, 0.2, 0.03, K, T, type);
+
+                EXPECT_NEAR(valuation.price, center, 1e-10);
+                EXPECT_NEAR(valuation.greeks.delta, (up - down) / (2 * dS), 1e-6);
+                EXPECT_NEAR(valuation.greeks.gamma, (up - 2 * center + down) / (dS * dS), 1e-4);
+                EXPECT_NEAR(valuation.greeks.vega,
+                            (priceAt(100.0, 0.2 + dV, 0.03, K, T, type) - priceAt(100.0, 0.2 - dV, 0.03, K, T, type)) / (2 * dV), 1e-4);
+                EXPECT_NEAR(valuation.greeks.rho,
+                            (priceAt(100.0, 0.2, 0.03 + dR, K, T, type) - priceAt(100.0, 0.2, 0.03 - dR, K, T, type)) / (2 * dR), 1e-4);
+                EXPECT_NEAR(valuation.greeks.theta,
+                            -(priceAt(100.0, 0.2, 0.03, K, T + dT, type) - priceAt(100.0, 0.2, 0.03, K, T - dT, type)) / (2 * dT), 1e-4);
+            }
+        }
+    }
+}
+
+TEST(HestonGreeks, PortfolioGreekVectorNoLongerThrows) {
+    AssetSP asset = makeHestonAsset();
+    Portfolio portfolio(Factory::makeSharedModel<Heston>());
+    portfolio.addOption(Factory::makeSharedOption(asset, 100.0, 1.0, OptionType::Call));
+    portfolio.addOption(Factory::makeSharedOption(asset, 90.0, 0.5, OptionType::Put));
+
+    std::vector<double> deltas = portfolio.greekVector(GreekType::Delta);
+    ASSERT_EQ(deltas.size(), 2u);
+    EXPECT_GT(deltas[0], 0.0);
+    EXPECT_LT(deltas[1], 0.0);
+}
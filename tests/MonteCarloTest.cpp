@@ -0,0 +1,212 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <OptionLib/OptionLib.h>
+#include <OptionLib/random/Philox.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    AssetSP makeAsset() {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", 100.0);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.05);
+        return asset;
+    }
+
+    void expectCloseToBlackScholes(const Valuation& valuation, const Option& option, double relTolerance) {
+        BlackScholes reference;
+        Greeks expected = reference.computeGreeks(option);
+        EXPECT_NEAR(valuation.price, reference.price(option), relTolerance * reference.price(option));
+        for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+            EXPECT_NEAR(valuation.greeks.get(type), expected.get(type), relTolerance * std::abs(expected.get(type)))
+                << "Greek " << static_cast<int>(type);
+        }
+    }
+
+} // namespace
+
+TEST(MonteCarloGreeks, PathwiseSinglePassMatchesBlackScholes) {
+    MonteCarlo model(GreekEstimator::Pathwise);
+    AssetSP asset = makeAsset();
+    expectCloseToBlackScholes(model.priceWithGreeks(Option(asset, 100.0, 1.0, OptionType::Call)),
+                              Option(asset, 100.0, 1.0, OptionType::Call), 0.02);
+    expectCloseToBlackScholes(model.priceWithGreeks(Option(asset, 110.0, 0.5, OptionType::Put)),
+                              Option(asset, 110.0, 0.5, OptionType::Put), 0.02);
+}
+
+TEST(MonteCarloGreeks, CommonRandomNumbersMatchesBlackScholes) {
+    MonteCarlo model(GreekEstimator::CommonRandomNumbers);
+    AssetSP asset = makeAsset();
+    Option call(asset, 100.0, 1.0, OptionType::Call);
+    expectCloseToBlackScholes(model.priceWithGreeks(call), call, 0.02);
+}
+
+TEST(MonteCarloReproducibility, IndependentOfThreadCount) {
+    AssetSP asset = makeAsset();
+    Option call(asset, 105.0, 1.0, OptionType::Call);
+
+    MonteCarlo serial(ExecutionContext::serial());
+    MonteCarlo pooled(ExecutionContext(3));
+    const std::uint64_t paths = 3 * MonteCarlo::PathBlockSize + 1234;
+
+    EXPECT_EQ(serial.simulate(call, paths).price(), pooled.simulate(call, paths).price());
+
+    pooled.setSeed(MonteCarlo::DefaultSeed + 1);
+    EXPECT_NE(serial.simulate(call, paths).price(), pooled.simulate(call, paths).price());
+}
+
+TEST(MonteCarloReproducibility, ResumedRunMatchesUninterruptedRun) {
+    AssetSP asset = makeAsset();
+    Option put(asset, 95.0, 0.75, OptionType::Put);
+    MonteCarlo model;
+
+    const std::uint64_t firstLeg = 2 * MonteCarlo::PathBlockSize;
+    MonteCarlo::Checkpoint checkpoint = model.simulate(put, firstLeg);
+    MonteCarlo::Checkpoint resumed = model.simulate(put, 100000, checkpoint);
+    MonteCarlo::Checkpoint oneShot = model.simulate(put, firstLeg + 100000);
+
+    EXPECT_EQ(resumed.numPaths(), oneShot.numPaths());
+    EXPECT_EQ(resumed.price(), oneShot.price());
+}
+
+TEST(MonteCarloVarianceReduction, AntitheticAndControlVariatesShrinkStandardError) {
+    AssetSP asset = makeAsset();
+    Option call(asset, 100.0, 1.0, OptionType::Call);
+    const double reference = BlackScholes().price(call);
+
+    MonteCarlo::Settings settings;
+    settings.maxPaths = 4 * MonteCarlo::PathBlockSize;
+    MonteCarlo::Estimate plain = MonteCarlo(settings).estimate(call);
+
+    settings.antithetic = true;
+    MonteCarlo::Estimate antithetic = MonteCarlo(settings).estimate(call);
+
+    settings.controlVariate = ControlVariate::TerminalSpot;
+    MonteCarlo::Estimate controlled = MonteCarlo(settings).estimate(call);
+
+    EXPECT_EQ(plain.numPaths, settings.maxPaths);
+    EXPECT_EQ(antithetic.numPaths, settings.maxPaths);
+    EXPECT_LT(antithetic.standardError, plain.standardError);
+    EXPECT_LT(controlled.standardError, antithetic.standardError);
+    for (const auto& estimate : {plain, antithetic, controlled}) {
+        EXPECT_NEAR(estimate.price, reference, 4 * estimate.standardError);
+    }
+
+    // A vanilla cannot be its own control; it falls back to the terminal spot
+    settings.controlVariate = ControlVariate::BlackScholes;
+    MonteCarlo::Estimate fallback = MonteCarlo(settings).estimate(call);
+    EXPECT_EQ(fallback.price, controlled.price);
+    EXPECT_EQ(fallback.standardError, controlled.standardError);
+}
+
+TEST(MonteCarloVarianceReduction, BlackScholesControlShrinksAsianError) {
+    AssetSP asset = makeAsset();
+    Option asian(asset, 100.0, 1.0, OptionType::Call, std::make_shared<AsianPayoff>(Averaging::Arithmetic, 12));
+
+    MonteCarlo::Settings settings;
+    settings.maxPaths = 2 * MonteCarlo::PathBlockSize;
+    MonteCarlo::Estimate plain = MonteCarlo(settings).estimate(asian);
+    settings.controlVariate = ControlVariate::BlackScholes;
+    MonteCarlo::Estimate controlled = MonteCarlo(settings).estimate(asian);
+
+    EXPECT_GT(controlled.standardError, 0.0);
+    EXPECT_LT(controlled.standardError, 0.6 * plain.standardError);
+    EXPECT_NEAR(controlled.price, plain.price, 4 * plain.standardError);
+}
+
+TEST(MonteCarloVarianceReduction, StopsAtTargetStandardError) {
+    AssetSP asset = makeAsset();
+    Option put(asset, 100.0, 1.0, OptionType::Put);
+
+    MonteCarlo::Settings settings;
+    settings.batchPaths = MonteCarlo::PathBlockSize;
+    settings.targetStandardError = 0.02;
+    MonteCarlo model(settings);
+
+    MonteCarlo::Estimate estimate = model.estimate(put);
+    EXPECT_LE(estimate.standardError, settings.targetStandardError);
+    EXPECT_LT(estimate.numPaths, settings.maxPaths);
+    EXPECT_EQ(estimate.numPaths % MonteCarlo::PathBlockSize, 0u);
+    EXPECT_NEAR(estimate.price, BlackScholes().price(put), 4 * estimate.standardError);
+    EXPECT_EQ(model.price(put), estimate.price);
+
+    // A run stopped early is the prefix of the full run
+    EXPECT_EQ(estimate.price, model.simulate(put, estimate.numPaths).price());
+}
+
+TEST(MonteCarloVarianceReduction, StopsAtDeadline) {
+    AssetSP asset = makeAsset();
+    Option call(asset, 100.0, 1.0, OptionType::Call);
+
+    MonteCarlo::Settings settings;
+    settings.maxPaths = 1'000'000'000;
+    settings.batchPaths = MonteCarlo::PathBlockSize;
+    settings.deadline = std::chrono::milliseconds(50);
+
+    MonteCarlo::Estimate estimate = MonteCarlo(settings).estimate(call);
+    EXPECT_GE(estimate.numPaths, settings.batchPaths);
+    EXPECT_LT(estimate.numPaths, settings.maxPaths);
+}
+
+TEST(MonteCarloQuasiRandom, SobolConvergesFasterThanPseudoRandom) {
+    AssetSP asset = makeAsset();
+    Option call(asset, 100.0, 1.0, OptionType::Call);
+    const double reference = BlackScholes().price(call);
+
+    MonteCarlo::Settings settings;
+    settings.maxPaths = 16 * MonteCarlo::PathBlockSize;
+    MonteCarlo::Estimate pseudo = MonteCarlo(settings).estimate(call);
+
+    settings.sampling = Sampling::Sobol;
+    MonteCarlo::Estimate sobol = MonteCarlo(settings).estimate(call);
+
+    EXPECT_EQ(sobol.numPaths, settings.maxPaths);
+    EXPECT_LT(sobol.standardError, pseudo.standardError / 10);
+    EXPECT_NEAR(sobol.price, reference, 5 * sobol.standardError + 1e-4);
+
+    // Replicates run in parallel and the paths within them by index skipping; the answer is the
+    // same on any thread count
+    MonteCarlo serial(settings, ExecutionContext::serial());
+    MonteCarlo pooled(settings, ExecutionContext(3));
+    const MonteCarlo::Estimate serialEstimate = serial.estimate(call);
+    const MonteCarlo::Estimate pooledEstimate = pooled.estimate(call);
+    EXPECT_EQ(serialEstimate.price, pooledEstimate.price);
+    EXPECT_EQ(serialEstimate.standardError, pooledEstimate.standardError);
+}
+
+TEST(MonteCarloKernels, IdenticalAcrossVectorInstructionSets) {
+    AssetSP asset = makeAsset();
+    Option put(asset, 100.0, 1.0, OptionType::Put);
+    MonteCarlo model;
+    const std::uint64_t paths = MonteCarlo::PathBlockSize + 13;
+
+    setSimdLevel(SimdLevel::Scalar);
+    const double scalar = model.simulate(put, paths).price();
+    if (detectedSimdLevel() >= SimdLevel::AVX2) {
+        setSimdLevel(SimdLevel::AVX2);
+        const double avx2 = model.simulate(put, paths).price();
+        EXPECT_NEAR(avx2, scalar, 1e-12 * scalar);
+        if (detectedSimdLevel() >= SimdLevel::AVX512) {
+            setSimdLevel(SimdLevel::AVX512);
+            EXPECT_EQ(model.simulate(put, paths).price(), avx2);
+        }
+    }
+    setSimdLevel(detectedSimdLevel());
+
+    // The scalar kernel reproduces NormalStream's first draw of each path exactly
+    const double S = 100.0, r = 0.05, sigma = 0.2, K = 100.0, T = 1.0;
+    double payoffSum = 0.0;
+    for (std::uint64_t path = 0; path < paths; ++path) {
+        Random::NormalStream normals(MonteCarlo::DefaultSeed, path);
+        double ST = S * std::exp((r - 0.5 * sigma * sigma) * T + sigma * std::sqrt(T) * normals.next());
+        payoffSum += std::max(K - ST, 0.0);
+    }
+    EXPECT_NEAR(scalar, std::exp(-r * T) * payoffSum / paths, 1e-12 * scalar);
+}
@@ -0,0 +1,120 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    const double S = 100.0, r = 0.05, sigma = 0.2, T = 1.0;
+
+    AssetSP makeAsset() {
+        AssetSP asset = Factory::makeSharedAsset("AAPL", S);
+        asset->set(Param::volatility, sigma);
+        asset->set(Param::riskFreeRate, r);
+        return asset;
+    }
+
+    double normalCdf(double x) {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    MonteCarlo makeModel(std::uint64_t paths) {
+        MonteCarlo::Settings settings;
+        settings.maxPaths = paths;
+        settings.antithetic = true;
+        return MonteCarlo(settings);
+    }
+
+} // namespace
+
+TEST(PathDependent, GeometricAsianMatchesClosedForm) {
+    // ln G is normal for a discretely monitored geometric average
+    const double K = 100.0;
+    const int n = 12;
+    double mean = std::log(S) + (r - 0.5 * sigma * sigma) * T * (n + 1) / (2.0 * n);
+    double stdDev = sigma * std::sqrt(T * (n + 1) * (2.0 * n + 1) / (6.0 * n * n));
+    double d2 = (mean - std::log(K)) / stdDev;
+    double expected = std::exp(-r * T) * (std::exp(mean + 0.5 * stdDev * stdDev) * normalCdf(d2 + stdDev) - K * normalCdf(d2));
+
+    Option asian(makeAsset(), K, T, OptionType::Call, std::make_shared<AsianPayoff>(Averaging::Geometric, n));
+    MonteCarlo::Estimate estimate = makeModel(4 * MonteCarlo::PathBlockSize).estimate(asian);
+    EXPECT_NEAR(estimate.price, expected, 4 * estimate.standardError);
+
+    // The arithmetic average dominates the geometric one
+    Option arithmetic(makeAsset(), K, T, OptionType::Call, std::make_shared<AsianPayoff>(Averaging::Arithmetic, n));
+    EXPECT_GT(makeModel(4 * MonteCarlo::PathBlockSize).price(arithmetic), estimate.price);
+}
+
+TEST(PathDependent, BridgeCorrectedBarrierMatchesContinuousMonitoring) {
+    const double K = 100.0, H = 90.0;
+    double lambda = (r + 0.5 * sigma * sigma) / (sigma * sigma);
+    double y = std::log(H * H / (S * K)) / (sigma * std::sqrt(T)) + lambda * sigma * std::sqrt(T);
+    double downAndIn = S * std::pow(H / S, 2 * lambda) * normalCdf(y)
+                       - K * std::exp(-r * T) * std::pow(H / S, 2 * lambda - 2) * normalCdf(y - sigma * std::sqrt(T));
+    double vanilla = BlackScholes().price(Option(makeAsset(), K, T, OptionType::Call));
+
+    // Only 12 monitoring dates: without the crossing probability the knock-out would be far too rich
+    Option knockOut(makeAsset(), K, T, OptionType::Call, std::make_shared<BarrierPayoff>(BarrierType::DownAndOut, H, 12));
+    MonteCarlo::Estimate estimate = makeModel(4 * MonteCarlo::PathBlockSize).estimate(knockOut);
+    EXPECT_NEAR(estimate.price, vanilla - downAndIn, 4 * estimate.standardError);
+}
+
+TEST(PathDependent, KnockInPlusKnockOutIsVanillaPathByPath) {
+    AssetSP asset = makeAsset();
+    MonteCarlo model = makeModel(MonteCarlo::PathBlockSize);
+    for (auto [in, out] : {std::pair{BarrierType::UpAndIn, BarrierType::UpAndOut},
+                           std::pair{BarrierType::DownAndIn, BarrierType::DownAndOut}}) {
+        double level = (in == BarrierType::UpAndIn) ? 120.0 : 85.0;
+        Option knockIn(asset, 100.0, T, OptionType::Put, std::make_shared<BarrierPayoff>(in, level, 20));
+        Option knockOut(asset, 100.0, T, OptionType::Put, std::make_shared<BarrierPayoff>(out, level, 20));
+        // A barrier that is never reached leaves the vanilla payoff on the same 20-date paths
+        Option vanilla(asset, 100.0, T, OptionType::Put, std::make_shared<BarrierPayoff>(BarrierType::UpAndOut, 1e12, 20));
+        EXPECT_NEAR(model.price(knockIn) + model.price(knockOut), model.price(vanilla), 1e-10);
+    }
+}
+
+TEST(PathDependent, LookbacksDominateVanillas) {
+    AssetSP asset = makeAsset();
+    MonteCarlo model = makeModel(MonteCarlo::PathBlockSize);
+    BlackScholes blackScholes;
+    auto floating = std::make_shared<LookbackPayoff>(LookbackStrike::Floating, 50);
+    auto fixed = std::make_shared<LookbackPayoff>(LookbackStrike::Fixed, 50);
+
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        double vanilla = blackScholes.price(Option(asset, 100.0, T, type));
+        EXPECT_GT(model.price(Option(asset, 100.0, T, type, floating)), vanilla);
+        EXPECT_GT(model.price(Option(asset, 100.0, T, type, fixed)), vanilla);
+    }
+}
+
+TEST(PathDependent, QuasiRandomPathsAgreeWithPseudoRandom) {
+    // 30 dates exceed the Sobol dimensions, so the bridge's trailing normals come from Philox
+    Option asian(makeAsset(), 100.0, T, OptionType::Put, std::make_shared<AsianPayoff>(Averaging::Arithmetic, 30));
+    MonteCarlo::Settings settings;
+    settings.maxPaths = 4 * MonteCarlo::PathBlockSize;
+    MonteCarlo::Estimate pseudo = MonteCarlo(settings).estimate(asian);
+    settings.sampling = Sampling::Sobol;
+    MonteCarlo::Estimate sobol = MonteCarlo(settings).estimate(asian);
+
+    EXPECT_LT(sobol.standardError, pseudo.standardError);
+    EXPECT_NEAR(sobol.price, pseudo.price, 4 * std::hypot(sobol.standardError, pseudo.standardError));
+}
+
+TEST(PathDependent, GreeksAndModelSupport) {
+    AssetSP asset = makeAsset();
+    Option asian(asset, 100.0, T, OptionType::Call, std::make_shared<AsianPayoff>(Averaging::Arithmetic, 12));
+    Valuation valuation = makeModel(MonteCarlo::PathBlockSize).priceWithGreeks(asian);
+    EXPECT_GT(valuation.greeks.delta, 0.0);
+    EXPECT_LT(valuation.greeks.delta, 1.0);
+    EXPECT_GT(valuation.greeks.vega, 0.0);
+
+    // Models without a path simulation refuse rather than price the vanilla
+    EXPECT_THROW((void)BlackScholes().price(asian), std::invalid_argument);
+    EXPECT_THROW((void)Binomial().price(asian), std::invalid_argument);
+}
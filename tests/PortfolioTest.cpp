@@ -0,0 +1,442 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    // A book of cheap Black-Scholes items with lattice and Monte Carlo items mixed in
+    Portfolio makeBook(const ExecutionContext& context) {
+        AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+        asset->set(Param::volatility, 0.2);
+        asset->set(Param::riskFreeRate, 0.03);
+
+        Binomial::Settings latticeSettings;
+        latticeSettings.numSteps = 100;
+        ModelSP lattice = std::make_shared<Binomial>(latticeSettings, context);
+        MonteCarlo::Settings pathSettings;
+        pathSettings.maxPaths = 4096;
+        pathSettings.batchPaths = 4096;
+        ModelSP paths = std::make_shared<MonteCarlo>(pathSettings, context);
+
+        Portfolio book(Factory::makeSharedModel<BlackScholes>(), context);
+        for (int i = 0; i < 2000; ++i) {
+            OptionType type = i % 2 == 0 ? OptionType::Call : OptionType::Put;
+            book.addOption(Factory::makeSharedOption(asset, 70.0 + 0.03 * i, 0.1 + 0.001 * i, type));
+            if (i % 250 == 0) {
+                book.addOption(Factory::makeSharedOption(asset, 100.0, 1.0, type), lattice);
+                book.addOption(Factory::makeSharedOption(asset, 100.0, 1.0, type), paths);
+            }
+        }
+        return book;
+    }
+
+    // Black-Scholes, counting how often the portfolio asks for a value
+    class CountingModel : public BlackScholes {
+    public:
+        mutable std::atomic<int> prices{0};
+        mutable std::atomic<int> batches{0};
+        mutable std::atomic<int> greeks{0};
+        mutable std::atomic<GreekMask> lastMask{0};
+
+        double price(const Option& option) const override {
+            ++prices;
+            return BlackScholes::price(option);
+        }
+        void priceBatch(const OptionBatch& batch, std::span<double> out) const override {
+            prices += static_cast<int>(batch.options.size());
+            ++batches;
+            BlackScholes::priceBatch(batch, out);
+        }
+        Greeks computeGreeks(const Option& option, GreekMask mask) const override {
+            ++greeks;
+            lastMask = mask;
+            return BlackScholes::computeGreeks(option, mask);
+        }
+    };
+
+    // Heston, recording the size of each batch the portfolio asks for
+    class RecordingHeston : public Heston {
+    public:
+        using Heston::Heston;
+        mutable std::mutex mutex;
+        mutable std::vector<std::size_t> batchSizes;
+
+        void priceBatch(const OptionBatch& batch, std::span<double> out) const override {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                batchSizes.push_back(batch.options.size());
+            }
+            Heston::priceBatch(batch, out);
+        }
+    };
+
+    // Monte Carlo, counting the simulations behind prices and valuations
+    class CountingMonteCarlo : public MonteCarlo {
+    public:
+        using MonteCarlo::MonteCarlo;
+        mutable std::atomic<int> simulations{0};
+
+        double price(const Option& option) const override {
+            ++simulations;
+            return MonteCarlo::price(option);
+        }
+        Valuation priceWithGreeks(const Option& option, GreekMask mask) const override {
+            ++simulations;
+            return MonteCarlo::priceWithGreeks(option, mask);
+        }
+    };
+
+    // Worth 1 whatever the market, with no risk measures of its own
+    class FlatModel : public Model {
+    public:
+        double price(const Option&) const override { return 1.0; }
+        double computeGreek(const Option&, GreekType) const override { return 0.0; }
+        double VaR(const Option&, double, double) const override { throw std::logic_error("FlatModel::VaR"); }
+        double ExpectedShortfall(const Option&, double, double) const override {
+            throw std::logic_error("FlatModel::ExpectedShortfall");
+        }
+    };
+
+} // namespace
+
+TEST(Portfolio, TotalsAreIndependentOfThreads) {
+    Portfolio serial = makeBook(ExecutionContext::serial());
+    const double value = serial.totalValue();
+    const double delta = serial.totalGreek(GreekType::Delta);
+    const std::vector<Greeks> rows = serial.greekMatrix(greekBit(GreekType::Gamma));
+
+    for (unsigned threads : {2u, 4u}) {
+        Portfolio parallel = makeBook(ExecutionContext(threads));
+        for (int run = 0; run < 3; ++run) {
+            EXPECT_EQ(parallel.totalValue(), value) << threads << " threads";
+            EXPECT_EQ(parallel.totalGreek(GreekType::Delta), delta) << threads << " threads";
+        }
+        std::vector<Greeks> parallelRows = parallel.greekMatrix(greekBit(GreekType::Gamma));
+        ASSERT_EQ(parallelRows.size(), rows.size());
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            EXPECT_EQ(parallelRows[i].gamma, rows[i].gamma) << "item " << i;
+        }
+    }
+}
+
+TEST(Portfolio, QueriesMayRunOnThePortfoliosOwnPool) {
+    // Pool tasks query the book while the book's own queries wait on, and help run, the same pool
+    const ExecutionContext context(4);
+    Portfolio book = makeBook(context);
+    const double value = makeBook(ExecutionContext::serial()).totalValue();
+
+    std::vector<double> values(8);
+    context.parallelFor(0, values.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            if (k % 2 == 0) {
+                book.invalidateCache();
+            }
+            (void)book.greekMatrix(greekBit(GreekType::Delta));
+            values[k] = book.totalValue();
+        }
+    });
+    for (double v : values) {
+        EXPECT_EQ(v, value);
+    }
+}
+
+TEST(Portfolio, TotalsSumTheItemsInOrder) {
+    Portfolio book = makeBook({});
+    const std::vector<double> deltas = book.greekVector(GreekType::Delta);
+    EXPECT_EQ(book.totalGreek(GreekType::Delta), std::accumulate(deltas.begin(), deltas.end(), 0.0));
+
+    const std::map<std::string, double> shares = book.concentrationMeasures();
+    EXPECT_EQ(shares.size(), deltas.size());
+    double total = 0.0;
+    for (const auto& [name, share] : shares) {
+        total += share;
+    }
+    EXPECT_NEAR(total, 1.0, 1e-12);
+}
+
+TEST(Portfolio, ErrorsFromAnyItemPropagate) {
+    // Monte Carlo and lattice items do not implement VaR
+    Portfolio book = makeBook(ExecutionContext(4));
+    EXPECT_THROW((void)book.VaR(0.99, 10.0 / 252), std::logic_error);
+}
+
+TEST(Portfolio, RevaluesOnlyItemsWhoseInputsChanged) {
+    AssetSP first = Factory::makeSharedAsset("AAA", 100.0);
+    AssetSP second = Factory::makeSharedAsset("BBB", 50.0);
+    for (const AssetSP& asset : {first, second}) {
+        asset->set(Param::volatility, 0.25);
+        asset->set(Param::riskFreeRate, 0.02);
+    }
+    auto model = std::make_shared<CountingModel>();
+    Portfolio book(model);
+    std::vector<OptionSP> onSecond;
+    for (int i = 0; i < 30; ++i) {
+        book.addOption(Factory::makeSharedOption(first, 80.0 + i, 1.0, OptionType::Call));
+        onSecond.push_back(Factory::makeSharedOption(second, 40.0 + i, 0.5, OptionType::Put));
+        book.addOption(onSecond.back());
+    }
+
+    const double before = book.totalValue();
+    EXPECT_EQ(model->prices, 60);
+    EXPECT_EQ(model->batches, 2);
+    EXPECT_EQ(book.totalValue(), before);
+    (void)book.concentrationMeasures();
+    EXPECT_EQ(model->prices, 60);
+
+    // A spot move reprices only the options on that asset
+    second->setSpotPrice(51.0);
+    const double after = book.totalValue();
+    EXPECT_EQ(model->prices, 90);
+    EXPECT_NE(after, before);
+
+    // So does a change to an option's terms
+    onSecond.front()->setStrikePrice(41.0);
+    (void)book.totalValue();
+    EXPECT_EQ(model->prices, 91);
+
+    // Greeks already known are served from the cache, and only the missing ones are computed
+    (void)book.greekVector(GreekType::Delta);
+    EXPECT_EQ(model->greeks, 60);
+    std::vector<Greeks> rows = book.greekMatrix(greekBit(GreekType::Delta) | greekBit(GreekType::Vega));
+    EXPECT_EQ(model->greeks, 120);
+    (void)book.greekMatrix(greekBit(GreekType::Vega));
+    EXPECT_EQ(model->greeks, 120);
+    EXPECT_EQ(rows[1].gamma, 0.0);
+    EXPECT_EQ(rows[1].delta, BlackScholes().computeGreek(*onSecond.front(), GreekType::Delta));
+
+    const int counted = model->prices;
+    book.invalidateCache();
+    (void)book.totalValue();
+    EXPECT_EQ(model->prices, counted + 60);
+}
+
+TEST(Portfolio, PricesEachGroupInOneBatch) {
+    AssetSP first = Factory::makeSharedAsset("AAA", 100.0);
+    AssetSP second = Factory::makeSharedAsset("BBB", 50.0);
+    for (const AssetSP& asset : {first, second}) {
+        asset->set(Param::volatility, 0.25);
+        asset->set(Param::riskFreeRate, 0.02);
+    }
+    auto model = std::make_shared<CountingModel>();
+    ModelSP lattice = std::make_shared<Binomial>();
+    Portfolio book(model, ExecutionContext(2));
+    double expected = 0.0;
+    for (int i = 0; i < 40; ++i) {
+        const AssetSP& asset = i % 2 == 0 ? first : second;
+        const double quantity = i % 3 == 0 ? -2.0 : 5.0;
+        OptionSP option = Factory::makeSharedOption(asset, asset->getSpotPrice() * (0.8 + 0.01 * i), 0.25 + 0.05 * i,
+                                                    i % 4 == 0 ? OptionType::Put : OptionType::Call);
+        book.addOption(option, nullptr, quantity);
+        expected += quantity * BlackScholes().price(*option);
+        if (i % 10 == 0) {
+            book.addOption(option, lattice, quantity);
+            expected += quantity * lattice->price(*option);
+        }
+    }
+
+    // One batch per (model, asset) group of Black-Scholes positions
+    EXPECT_NEAR(book.totalValue(), expected, 1e-9);
+    EXPECT_EQ(model->prices, 40);
+    EXPECT_EQ(model->batches, 2);
+
+    // After a spot move only the stale group is batched again
+    first->setSpotPrice(101.0);
+    (void)book.totalValue();
+    EXPECT_EQ(model->prices, 60);
+    EXPECT_EQ(model->batches, 3);
+
+    // Greeks and totals are per position
+    const std::vector<double> deltas = book.greekVector(GreekType::Delta);
+    ASSERT_EQ(deltas.size(), 44u);
+    EXPECT_NEAR(deltas[0], -2.0 * BlackScholes().computeGreek(Option(first, 80.0, 0.25, OptionType::Put), GreekType::Delta), 1e-12);
+}
+
+TEST(Portfolio, PricesAHestonGroupAsOneBatch) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    asset->set(Param::volatility, 0.2);
+    asset->set(Param::riskFreeRate, 0.03);
+    asset->set(Param::meanReversion, 1.5);
+    asset->set(Param::longTermVariance, 0.04);
+    asset->set(Param::volOfVol, 0.5);
+    asset->set(Param::hestonCorrelation, -0.7);
+
+    const ExecutionContext context(4);
+    auto heston = std::make_shared<RecordingHeston>(context);
+    Portfolio book(Factory::makeSharedModel<BlackScholes>(), context);
+    double expected = 0.0;
+    for (int i = 0; i < 60; ++i) {
+        OptionSP option = Factory::makeSharedOption(asset, 70.0 + i, i % 2 == 0 ? 0.5 : 1.0, OptionType::Put);
+        book.addOption(option, heston);
+        book.addOption(option);
+        expected += Heston().price(*option) + BlackScholes().price(*option);
+    }
+
+    // Despite Heston's relativeCost, its 60 rows reach priceBatch together
+    EXPECT_NEAR(book.totalValue(), expected, 1e-9);
+    ASSERT_EQ(heston->batchSizes.size(), 1u);
+    EXPECT_EQ(heston->batchSizes[0], 60u);
+
+    asset->setSpotPrice(101.0);
+    (void)book.totalValue();
+    ASSERT_EQ(heston->batchSizes.size(), 2u);
+    EXPECT_EQ(heston->batchSizes[1], 60u);
+}
+
+TEST(Portfolio, RiskReportMatchesTheIndividualQueries) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    asset->set(Param::volatility, 0.2);
+    asset->set(Param::riskFreeRate, 0.03);
+    auto buildBook = [&] {
+        Portfolio book(Factory::makeSharedModel<BlackScholes>(), ExecutionContext(2));
+        for (int i = 0; i < 50; ++i) {
+            OptionSP option = Factory::makeSharedOption(asset, 80.0 + i, 0.5 + 0.01 * i, i % 2 ? OptionType::Call : OptionType::Put);
+            if (i % 5 == 0) {
+                option->setId("trade-" + std::to_string(i));
+            }
+            book.addOption(option, nullptr, i % 3 == 0 ? -4.0 : 2.0);
+        }
+        return book;
+    };
+
+    Portfolio::ReportRequest request;
+    request.valueAtRisk = true;
+    const Portfolio::RiskReport report = buildBook().riskReport(request);
+    const Portfolio book = buildBook();
+
+    EXPECT_NEAR(report.totalValue, book.totalValue(), 1e-9);
+    EXPECT_NEAR(report.VaR, book.VaR(request.confidenceLevel, request.holdingPeriod), 1e-9);
+    EXPECT_NEAR(report.expectedShortfall, book.ExpectedShortfall(request.confidenceLevel, request.holdingPeriod), 1e-9);
+    for (GreekType type : {GreekType::Delta, GreekType::Gamma, GreekType::Vega, GreekType::Theta, GreekType::Rho}) {
+        EXPECT_NEAR(report.totalGreeks.get(type), book.totalGreek(type), 1e-9);
+    }
+
+    ASSERT_EQ(report.positions.size(), 50u);
+    const std::vector<double> deltas = book.greekVector(GreekType::Delta);
+    double shares = 0.0;
+    for (std::size_t i = 0; i < report.positions.size(); ++i) {
+        EXPECT_NEAR(report.positions[i].greeks.delta, deltas[i], 1e-12);
+        shares += report.positions[i].share;
+    }
+    EXPECT_NEAR(shares, 1.0, 1e-12);
+    EXPECT_EQ(report.positions[0].id, "trade-0");
+    EXPECT_EQ(report.positions[0].quantity, -4.0);
+    EXPECT_EQ(report.positions[1].id, "SPX Call 81 0.51");
+}
+
+TEST(Portfolio, RiskReportEvaluatesEachItemOnce) {
+    AssetSP asset = Factory::makeSharedAsset("AAA", 100.0);
+    asset->set(Param::volatility, 0.25);
+    asset->set(Param::riskFreeRate, 0.02);
+    auto model = std::make_shared<CountingModel>();
+    Portfolio book(model);
+    for (int i = 0; i < 20; ++i) {
+        book.addOption(Factory::makeSharedOption(asset, 90.0 + i, 1.0, OptionType::Call));
+    }
+
+    const Portfolio::RiskReport report = book.riskReport();
+    EXPECT_EQ(model->prices, 20);
+    EXPECT_EQ(model->batches, 0);
+    EXPECT_EQ(model->greeks, 20);
+    EXPECT_EQ(report.positions[3].VaR, 0.0);
+
+    // The report fills the cache for the individual queries, and vice versa
+    EXPECT_EQ(book.totalValue(), report.totalValue);
+    (void)book.greekMatrix();
+    (void)book.riskReport();
+    EXPECT_EQ(model->prices, 20);
+    EXPECT_EQ(model->greeks, 20);
+
+    // Prices alone go through the batch path
+    asset->setSpotPrice(101.0);
+    Portfolio::ReportRequest pricesOnly;
+    pricesOnly.greeks = 0;
+    (void)book.riskReport(pricesOnly);
+    EXPECT_EQ(model->batches, 1);
+    EXPECT_EQ(model->greeks, 20);
+
+    // Only the requested Greeks are computed
+    Portfolio::ReportRequest deltaOnly;
+    deltaOnly.greeks = greekBit(GreekType::Delta);
+    (void)book.riskReport(deltaOnly);
+    EXPECT_EQ(model->greeks, 40);
+    EXPECT_EQ(model->lastMask, greekBit(GreekType::Delta));
+}
+
+TEST(Portfolio, RiskReportRunsOneSimulationPerItem) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    asset->set(Param::volatility, 0.2);
+    asset->set(Param::riskFreeRate, 0.03);
+    MonteCarlo::Settings settings;
+    settings.targetStandardError = 0.05;
+    settings.maxPaths = 1 << 16;
+    auto paths = std::make_shared<CountingMonteCarlo>(settings);
+    Portfolio book(paths);
+    double expected = 0.0;
+    for (int i = 0; i < 6; ++i) {
+        OptionSP option = Factory::makeSharedOption(asset, 90.0 + 4.0 * i, 1.0, OptionType::Call);
+        book.addOption(option);
+        expected += MonteCarlo(settings).priceWithGreeks(*option).price;
+    }
+
+    // On a cold cache the simulation behind the Greeks also prices the item, and totalValue
+    // reads that price
+    const Portfolio::RiskReport report = book.riskReport();
+    EXPECT_EQ(paths->simulations, 6);
+    EXPECT_EQ(report.totalValue, expected);
+    EXPECT_EQ(book.totalValue(), report.totalValue);
+    EXPECT_EQ(paths->simulations, 6);
+
+    // With prices already cached, the report keeps them
+    asset->setSpotPrice(101.0);
+    const double before = book.totalValue();
+    EXPECT_EQ(book.riskReport().totalValue, before);
+    EXPECT_EQ(book.totalValue(), before);
+}
+
+TEST(Portfolio, RiskReportMeasuresValueAtRiskForEveryModel) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    asset->set(Param::volatility, 0.2);
+    asset->set(Param::riskFreeRate, 0.03);
+    AssetSP unquoted = Factory::makeSharedAsset("OTC", 100.0);
+    Binomial::Settings latticeSettings;
+    latticeSettings.numSteps = 100;
+    ModelSP lattice = std::make_shared<Binomial>(latticeSettings);
+
+    Portfolio book(Factory::makeSharedModel<BlackScholes>());
+    OptionSP vanilla = Factory::makeSharedOption(asset, 100.0, 1.0, OptionType::Put);
+    book.addOption(vanilla, nullptr, -3.0);
+    book.addOption(Factory::makeSharedOption(asset, 95.0, 0.5, OptionType::Call), lattice, 2.0);
+    book.addOption(Factory::makeSharedOption(unquoted, 100.0, 1.0, OptionType::Call), std::make_shared<FlatModel>());
+
+    Portfolio::ReportRequest request;
+    request.valueAtRisk = true;
+    const Portfolio::RiskReport report = book.riskReport(request);
+    ASSERT_EQ(report.positions.size(), 3u);
+
+    // The lattice's own VaR is not implemented, but the report still measures the position
+    const double c = request.confidenceLevel;
+    const double h = request.holdingPeriod;
+    EXPECT_NEAR(report.positions[0].VaR, 3.0 * BlackScholes().VaR(*vanilla, c, h), 1e-9);
+    EXPECT_NEAR(report.positions[0].expectedShortfall, 3.0 * BlackScholes().ExpectedShortfall(*vanilla, c, h), 1e-9);
+    const double latticePrice = report.positions[1].value / 2.0;
+    EXPECT_EQ(report.positions[1].VaR, 2.0 * BlackScholes::lognormalVaR(latticePrice, 0.2, c, h));
+    EXPECT_TRUE(report.positions[1].hasValueAtRisk);
+
+    // A position without a volatility is flagged rather than failing the report
+    EXPECT_FALSE(report.positions[2].hasValueAtRisk);
+    EXPECT_EQ(report.positions[2].VaR, 0.0);
+    EXPECT_EQ(report.positions[2].value, 1.0);
+    EXPECT_EQ(report.VaR, report.positions[0].VaR + report.positions[1].VaR);
+}
@@ -0,0 +1,140 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <OptionLib/random/BrownianBridge.h>
+#include <OptionLib/random/Normal.h>
+#include <OptionLib/random/Philox.h>
+#include <OptionLib/random/Sobol.h>
+
+using namespace OptionLib::Random;
+
+TEST(Philox, KnownAnswerVectors) {
+    // Reference outputs from the Random123 distribution (kat_vectors, philox4x32 with 10 rounds)
+    auto zero = Philox4x32::generate({0, 0, 0, 0}, {0, 0});
+    EXPECT_EQ(zero, (Philox4x32::Counter{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+
+    auto ones = Philox4x32::generate({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu});
+    EXPECT_EQ(ones, (Philox4x32::Counter{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+
+    auto pi = Philox4x32::generate({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u});
+    EXPECT_EQ(pi, (Philox4x32::Counter{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+}
+
+TEST(Philox, SkipAheadMatchesSequentialDraws) {
+    NormalStream sequential(7, 123456789);
+    double draws[9];
+    for (double& draw : draws) {
+        draw = sequential.next();
+    }
+    for (int j : {0, 1, 4, 7, 8}) {
+        NormalStream jumped(7, 123456789);
+        jumped.skipTo(j);
+        EXPECT_EQ(jumped.next(), draws[j]) << "draw " << j;
+    }
+}
+
+TEST(Philox, NormalMoments) {
+    double sum = 0.0, sumSq = 0.0;
+    const int n = 200000;
+    for (int path = 0; path < n; ++path) {
+        double z = NormalStream(42, path).next();
+        sum += z;
+        sumSq += z * z;
+    }
+    EXPECT_NEAR(sum / n, 0.0, 0.01);
+    EXPECT_NEAR(sumSq / n, 1.0, 0.01);
+}
+
+TEST(Sobol, FirstPointsMatchReferenceSequence) {
+    // Gray-code ordered Sobol points, shifted to the centre of their 2^-32 cell
+    const double dim1[] = {0.0, 0.5, 0.75, 0.25, 0.375, 0.875, 0.625, 0.125};
+    const double dim2[] = {0.0, 0.5, 0.25, 0.75, 0.375, 0.875, 0.125, 0.625};
+    Sobol sobol(2);
+    for (int n = 0; n < 8; ++n) {
+        double point[2];
+        sobol.next(point);
+        EXPECT_NEAR(point[0], dim1[n], 1e-9) << "point " << n;
+        EXPECT_NEAR(point[1], dim2[n], 1e-9) << "point " << n;
+    }
+}
+
+TEST(Sobol, SkipAheadMatchesSequentialPoints) {
+    Sobol sequential(Sobol::MaxDimensions, 42);
+    std::vector<double> points(1000 * Sobol::MaxDimensions);
+    for (int n = 0; n < 1000; ++n) {
+        sequential.next(&points[n * Sobol::MaxDimensions]);
+    }
+    for (int n : {0, 1, 511, 512, 999}) {
+        Sobol jumped(Sobol::MaxDimensions, 42);
+        jumped.skipTo(n);
+        std::vector<double> point(Sobol::MaxDimensions);
+        jumped.next(point.data());
+        for (unsigned d = 0; d < Sobol::MaxDimensions; ++d) {
+            EXPECT_EQ(point[d], points[n * Sobol::MaxDimensions + d]);
+        }
+    }
+}
+
+TEST(Sobol, EveryDimensionIsEquidistributed) {
+    // The first 2^k points of each dimension put exactly one point in every interval of width 2^-k,
+    // whatever the digital shift
+    Sobol sobol(Sobol::MaxDimensions, 7);
+    const int n = 1024;
+    std::vector<std::vector<int>> counts(Sobol::MaxDimensions, std::vector<int>(n, 0));
+    std::vector<double> point(Sobol::MaxDimensions);
+    for (int i = 0; i < n; ++i) {
+        sobol.next(point.data());
+        for (unsigned d = 0; d < Sobol::MaxDimensions; ++d) {
+            ++counts[d][static_cast<int>(point[d] * n)];
+        }
+    }
+    for (unsigned d = 0; d < Sobol::MaxDimensions; ++d) {
+        EXPECT_EQ(*std::min_element(counts[d].begin(), counts[d].end()), 1) << "dimension " << d;
+    }
+    EXPECT_THROW(Sobol(Sobol::MaxDimensions + 1), std::invalid_argument);
+}
+
+TEST(InverseNormalCdf, RoundTripsThroughErfc) {
+    for (double p : {1e-300, 1e-12, 0.001, 0.02425, 0.1, 0.5, 0.7, 0.975, 1.0 - 1e-10}) {
+        double x = inverseNormalCdf(p);
+        double roundTrip = p < 0.5 ? 0.5 * std::erfc(-x / std::sqrt(2.0)) : 1.0 - 0.5 * std::erfc(x / std::sqrt(2.0));
+        EXPECT_NEAR(roundTrip / p, 1.0, 1e-13) << "p = " << p;
+    }
+    EXPECT_EQ(inverseNormalCdf(0.5), 0.0);
+    EXPECT_NEAR(inverseNormalCdf(0.975), 1.959963984540054, 1e-14);
+}
+
+TEST(BrownianBridge, ReproducesBrownianCovariance) {
+    // The path is linear in the normals; its covariance A A^T must equal min(t_i, t_j)
+    BrownianBridge bridge({0.1, 0.25, 0.3, 0.7, 0.8, 1.0, 1.5});
+    const std::size_t n = bridge.size();
+    std::vector<std::vector<double>> columns(n, std::vector<double>(n));
+    for (std::size_t k = 0; k < n; ++k) {
+        std::vector<double> unit(n, 0.0);
+        unit[k] = 1.0;
+        bridge.build(unit.data(), columns[k].data());
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            double covariance = 0.0;
+            for (std::size_t k = 0; k < n; ++k) {
+                covariance += columns[k][i] * columns[k][j];
+            }
+            EXPECT_NEAR(covariance, std::min(bridge.times()[i], bridge.times()[j]), 1e-12);
+        }
+    }
+
+    // The first normal alone sets the terminal value
+    std::vector<double> first(n, 0.0);
+    first[0] = 1.0;
+    std::vector<double> path(n);
+    bridge.build(first.data(), path.data());
+    EXPECT_NEAR(path[n - 1], std::sqrt(1.5), 1e-15);
+    EXPECT_THROW(BrownianBridge(std::vector<double>{0.5, 0.5}), std::invalid_argument);
+}
@@ -0,0 +1,152 @@
+//
+// Created by James Wirth on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <OptionLib/OptionLib.h>
+
+using namespace OptionLib;
+using namespace OptionLib::Models;
+
+namespace {
+
+    // A skewed smile whose at-the-money volatility falls with expiry, slowly enough that total
+    // variance still rises
+    double smile(double K, double T) {
+        double k = std::log(K / 100.0);
+        return 0.2 + 0.02 / std::sqrt(T) - 0.1 * k + 0.3 * k * k;
+    }
+
+    std::vector<VolatilityQuote> makeQuotes(std::initializer_list<double> expiries) {
+        std::vector<VolatilityQuote> quotes;
+        for (double T : expiries) {
+            for (double K : {60.0, 75.0, 90.0, 100.0, 110.0, 125.0, 150.0}) {
+                quotes.push_back({K, T, smile(K, T)});
+            }
+        }
+        return quotes;
+    }
+
+} // namespace
+
+TEST(VolSurface, ReproducesQuotesAndInterpolatesTotalVariance) {
+    VolSurface surface(makeQuotes({1.0, 0.25, 0.5, 2.0}));
+    ASSERT_EQ(surface.getExpiries(), (std::vector<double>{0.25, 0.5, 1.0, 2.0}));
+
+    for (const VolatilityQuote& quote : makeQuotes({0.25, 0.5, 1.0, 2.0})) {
+        EXPECT_NEAR(surface.volatility(quote.strike, quote.expiry), quote.impliedVolatility, 1e-14);
+    }
+
+    // Linear in total variance between expiries at a fixed strike
+    const double w1 = surface.totalVariance(95.0, 1.0), w2 = surface.totalVariance(95.0, 2.0);
+    EXPECT_NEAR(surface.totalVariance(95.0, 1.25), 0.75 * w1 + 0.25 * w2, 1e-14);
+
+    // Flat volatility outside the quoted expiries
+    EXPECT_NEAR(surface.volatility(95.0, 0.1), surface.volatility(95.0, 0.25), 1e-14);
+    EXPECT_NEAR(surface.volatility(95.0, 5.0), surface.volatility(95.0, 2.0), 1e-14);
+}
+
+TEST(VolSurface, StrikeInterpolationIsSmoothAndShapePreserving) {
+    VolSurface surface(makeQuotes({1.0}));
+
+    // No overshoot on the monotone part of the smile, and continuous slopes at the quotes
+    for (double K = 60.0; K < 75.0; K += 0.5) {
+        EXPECT_LE(surface.volatility(K, 1.0), smile(60.0, 1.0));
+        EXPECT_GE(surface.volatility(K, 1.0), smile(75.0, 1.0));
+    }
+    for (double K : {75.0, 90.0, 110.0, 125.0}) {
+        const double h = 1e-6 * K;
+        const double left = (surface.totalVariance(K, 1.0) - surface.totalVariance(K - h, 1.0)) / h;
+        const double right = (surface.totalVariance(K + h, 1.0) - surface.totalVariance(K, 1.0)) / h;
+        EXPECT_NEAR(left, right, 1e-6) << "K=" << K;
+    }
+
+    // The wings rise from the quotes, no faster than Lee's bound dw/dk <= 2
+    const double far = surface.totalVariance(1000.0, 1.0), edge = surface.totalVariance(150.0, 1.0);
+    EXPECT_GE(far, edge);
+    EXPECT_LE(far - edge, 2.0 * std::log(1000.0 / 150.0) + 1e-12);
+    EXPECT_GE(surface.totalVariance(10.0, 1.0), surface.totalVariance(60.0, 1.0));
+}
+
+TEST(VolSurface, RejectsCalendarArbitrage) {
+    VolSurface surface(makeQuotes({0.5, 1.0}));
+    std::vector<VolatilityQuote> lower = {{100.0, 1.0, 0.1}};
+    EXPECT_THROW(surface.update(lower), std::invalid_argument);
+
+    // A rejected update leaves the surface as it was
+    EXPECT_NEAR(surface.volatility(100.0, 1.0), smile(100.0, 1.0), 1e-14);
+
+    std::vector<VolatilityQuote> duplicate = {{100.0, 3.0, 0.2}, {100.0, 3.0, 0.25}};
+    EXPECT_THROW(surface.update(duplicate), std::invalid_argument);
+    EXPECT_THROW((void)VolSurface().volatility(100.0, 1.0), std::runtime_error);
+}
+
+TEST(VolSurface, UpdatesOnlyTheQuotedExpiries) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    asset->updateVolSurface(makeQuotes({0.25, 0.5, 1.0}));
+    std::shared_ptr<const VolSurface> before = asset->getVolSurface();
+    const std::uint64_t version = asset->getVersion();
+
+    std::vector<VolatilityQuote> bumped;
+    for (VolatilityQuote quote : makeQuotes({0.5, 2.0})) {
+        quote.impliedVolatility += 0.01;
+        bumped.push_back(quote);
+    }
+    asset->updateVolSurface(bumped);
+    const VolSurface& after = *asset->getVolSurface();
+
+    EXPECT_GT(asset->getVersion(), version);
+    EXPECT_EQ(after.getExpiries(), (std::vector<double>{0.25, 0.5, 1.0, 2.0}));
+    EXPECT_NEAR(after.volatility(90.0, 0.5), smile(90.0, 0.5) + 0.01, 1e-14);
+    EXPECT_EQ(after.volatility(93.0, 0.25), before->volatility(93.0, 0.25));
+    EXPECT_EQ(after.volatility(93.0, 1.0), before->volatility(93.0, 1.0));
+
+    // Anyone still holding the old surface sees it unchanged
+    EXPECT_NEAR(before->volatility(90.0, 0.5), smile(90.0, 0.5), 1e-14);
+    EXPECT_EQ(before->getExpiries().size(), 3u);
+}
+
+TEST(VolSurface, ModelsPriceAtTheOptionsVolatility) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    asset->set(Param::riskFreeRate, 0.03);
+    asset->updateVolSurface(makeQuotes({0.5, 1.0}));
+
+    AssetSP flat = Factory::makeSharedAsset("SPX", 100.0);
+    flat->set(Param::riskFreeRate, 0.03);
+
+    for (double K : {80.0, 100.0, 130.0}) {
+        Option option(asset, K, 0.75, OptionType::Put);
+        flat->set(Param::volatility, asset->getVolSurface()->volatility(K, 0.75));
+        Option flatOption(flat, K, 0.75, OptionType::Put);
+
+        EXPECT_DOUBLE_EQ(BlackScholes().price(option), BlackScholes().price(flatOption)) << "K=" << K;
+        Binomial::Settings settings;
+        settings.numSteps = 200;
+        EXPECT_DOUBLE_EQ(Binomial(settings).price(option), Binomial(settings).price(flatOption)) << "K=" << K;
+    }
+}
+
+TEST(VolSurface, SnapshotComesWithItsSurface) {
+    AssetSP asset = Factory::makeSharedAsset("SPX", 100.0);
+    const VolSurface* surface = nullptr;
+    (void)asset->snapshot(surface);
+    EXPECT_EQ(surface, nullptr);
+
+    asset->updateVolSurface(makeQuotes({0.5, 1.0}));
+    const MarketSnapshot market = asset->snapshot(surface);
+    EXPECT_EQ(surface, asset->getVolSurface().get());
+    EXPECT_EQ(market.version, asset->getVersion());
+    const double before = surface->volatility(90.0, 0.75);
+
+    // A new surface comes with a new version, so the pair never mixes old and new data
+    std::vector<VolatilityQuote> bumped = makeQuotes({0.5, 1.0});
+    for (VolatilityQuote& quote : bumped) {
+        quote.impliedVolatility += 0.05;
+    }
+    asset->updateVolSurface(bumped);
+    const MarketSnapshot after = asset->snapshot(surface);
+    EXPECT_GT(after.version, market.version);
+    EXPECT_NEAR(surface->volatility(90.0, 0.75), before + 0.05, 0.01);
+}